@@ -1,23 +1,35 @@
 // 自定义字符串类头文件，实现深拷贝语义的字符串管理
 // 核心特性：封装动态字符数组资源、支持C风格字符串互转、重载相等比较运算符
 // 设计思路：遵循RAII（资源获取即初始化）原则，通过深拷贝避免浅拷贝导致的内存问题
+// 内存来源：默认使用new char[]/delete[]；也可指定std::pmr::memory_resource，
+//           或使用string_arena（单调内存池）批量分配、整体释放
 #ifndef STRING_HPP
 #define STRING_HPP
 
 // 包含标准C字符串操作头文件，提供memcmp(内存比较)/memcpy(内存拷贝)/strlen(字符串长度)/size_t(无符号长度类型)
 #include <string.h>  
+// 提供std::pmr::memory_resource（多态内存资源）和std::pmr::monotonic_buffer_resource（单调内存池）
+#include <memory_resource>
+
+// 字符串专用的内存池（arena）：在单调内存池的基础上，作为String的“快速路径”标记
+// 特点：分配只是移动指针；单个字符串析构时不归还内存，release()或内存池析构时一次性整体释放
+// 注意：从内存池分配的String不能比内存池活得更久
+class string_arena : public std::pmr::monotonic_buffer_resource {
+public:
+    using std::pmr::monotonic_buffer_resource::monotonic_buffer_resource;
+};
 
 // 自定义String类，封装字符串的存储、拷贝、比较等核心操作
 class String {
 public:
     // 默认构造函数：初始化空字符串
     // 初始状态：指针置空（无动态内存分配），长度为0
-    String() : ptr_(nullptr), len_(0) {}
+    String() : ptr_(nullptr), len_(0), mr_(nullptr), arena_(false) {}
 
     // 带C风格字符串的构造函数：从const char*类型初始化字符串
     // 参数s：C风格字符串（以'\0'结尾）
     // 核心逻辑：深拷贝s的内容，len_记录有效字符长度（不含'\0'），分配内存时+1预留'\0'的空间
-    String(const char* s) : ptr_(nullptr), len_(strlen(s))
+    String(const char* s) : ptr_(nullptr), len_(strlen(s)), mr_(nullptr), arena_(false)
     {
         // 仅当字符串非空时分配内存（避免空指针操作）
         if (len_ != 0) {
@@ -26,10 +38,34 @@ public:
         }
     }
 
+    // 指定内存资源的构造函数：从内存资源mr分配字符数组
+    // 参数mr：内存资源（为nullptr时等同于使用new/delete的默认版本）
+    // 析构时通过mr->deallocate归还内存
+    String(const char* s, std::pmr::memory_resource* mr)
+        : ptr_(nullptr), len_(strlen(s)), mr_(mr), arena_(false)
+    {
+        if (len_ != 0) {
+            ptr_ = allocate(len_ + 1);
+            memcpy(ptr_, s, len_ + 1);
+        }
+    }
+
+    // 使用内存池的构造函数（快速路径）：从arena分配，析构时跳过释放
+    // 内存在arena.release()或arena析构时统一归还
+    String(const char* s, string_arena& arena)
+        : ptr_(nullptr), len_(strlen(s)), mr_(&arena), arena_(true)
+    {
+        if (len_ != 0) {
+            ptr_ = allocate(len_ + 1);
+            memcpy(ptr_, s, len_ + 1);
+        }
+    }
+
     // 拷贝构造函数：实现深拷贝，避免浅拷贝导致的多个对象共享同一块内存
     // 参数rhs：待拷贝的String对象（const保证不修改源对象）
     // 核心逻辑：独立分配内存，拷贝源对象的字符串内容，与源对象解耦
-    String(const String& rhs) : ptr_(nullptr), len_(rhs.len_)
+    // 注意：与std::pmr容器一致，拷贝不传播内存资源，新对象使用new/delete
+    String(const String& rhs) : ptr_(nullptr), len_(rhs.len_), mr_(nullptr), arena_(false)
     {
         // 仅当源对象非空时分配内存
         if (len_ != 0) {
@@ -52,12 +88,12 @@ public:
         // 自赋值检查：若当前对象与源对象是同一个，直接返回（避免释放自身内存后拷贝）
         if (this != &rhs) {
             char* ptr = nullptr;
-            // 源对象非空时，分配新内存并拷贝内容
+            // 源对象非空时，分配新内存并拷贝内容（使用当前对象自己的内存资源）
             if (rhs.len_ != 0) {
-                ptr = new char[rhs.len_ + 1];
+                ptr = allocate(rhs.len_ + 1);
                 memcpy(ptr, rhs.ptr_, rhs.len_ + 1);  // 拷贝含'\0'的完整字符串
             }
-            delete[] ptr_;  // 释放当前对象的旧内存，避免内存泄漏
+            deallocate();   // 释放当前对象的旧内存，避免内存泄漏
             ptr_ = ptr;     // 指向新分配的内存
             len_ = rhs.len_;// 更新字符串长度
         }
@@ -68,8 +104,7 @@ public:
     // 核心作用：对象销毁时自动释放内存，避免内存泄漏
     ~String()
     {
-        // 释放动态分配的字符数组（必须用 delete[]，而非 delete，否则会导致内存释放不完整）。
-        delete[] ptr_;  // 释放数组需用delete[]，与new char[]匹配
+        deallocate();
     }
 
     // 获取C风格字符串指针（const版本，保证不修改内部资源）
@@ -104,9 +139,38 @@ public:
         return memcmp(lhs.ptr_, rhs.ptr_, lhs.len_) == 0;
     }
 
+    // 获取字符串使用的内存资源（nullptr表示使用new/delete）
+    std::pmr::memory_resource* resource() const
+    {
+        return mr_;
+    }
+
 private:
+    // 按当前对象的内存资源分配size个字节
+    char* allocate(size_t size) const
+    {
+        if (mr_ == nullptr) {
+            return new char[size];
+        }
+        return static_cast<char*>(mr_->allocate(size, alignof(char)));
+    }
+
+    // 按当前对象的内存资源释放字符数组
+    // 内存池（arena_为true）的快速路径：什么都不做，内存随内存池整体释放
+    void deallocate()
+    {
+        if (mr_ == nullptr) {
+            // 释放动态分配的字符数组（必须用 delete[]，而非 delete，否则会导致内存释放不完整）。
+            delete[] ptr_;  // 释放数组需用delete[]，与new char[]匹配
+        } else if (!arena_ && ptr_ != nullptr) {
+            mr_->deallocate(ptr_, len_ + 1, alignof(char));
+        }
+    }
+
     char*  ptr_;   // 指向动态分配的字符数组，存储以'\0'结尾的字符串，空字符串时为nullptr
     size_t len_;   // 字符串有效长度（不含终止符'\0'），空字符串时为0
+    std::pmr::memory_resource* mr_;  // 内存资源，为nullptr时使用new char[]/delete[]
+    bool   arena_; // mr_是否为string_arena（为true时析构跳过释放）
 };
 
 // 内联成员函数：assign的实现（内联提升调用效率）
@@ -117,10 +181,10 @@ inline void String::assign(const char* s)
     char* ptr = nullptr;
     // 新字符串非空时分配内存（含'\0'）
     if (len != 0) {
-        ptr = new char[len + 1];
+        ptr = allocate(len + 1);
         memcpy(ptr, s, len + 1);  // 拷贝含'\0'的完整字符串
     }
-    delete[] ptr_;  // 释放旧内存
+    deallocate();   // 释放旧内存
     ptr_ = ptr;     // 指向新内存
     len_ = len;     // 更新长度
 }
@@ -0,0 +1,394 @@
+// 基于返回值的错误处理头文件：C++17版的expected<T, E>（接口仿照C++23的std::expected）
+// 核心特性：
+//   1. expected<T, E>要么持有值T，要么持有错误E；T可以是void（只表示成功/失败）
+//   2. 单子式（monadic）组合：and_then/or_else/transform/transform_error，
+//      失败时自动跳过后续步骤，把错误原样传递下去
+//   3. 传播辅助宏EXPECTED_TRY/EXPECTED_CHECK：相当于“出错就提前返回”，
+//      用来代替stack_unwind.cpp中的throw——错误沿调用链逐层返回，局部对象照常析构
+// 设计思路：与异常相比，失败路径只是普通的返回（一次分支），代价与成功路径相当，
+//           适合失败率不可忽略（如1%~5%）的热点路径；代价是每一层都要检查结果
+#ifndef EXPECTED_HPP
+#define EXPECTED_HPP
+
+#include <exception>   // 提供std::exception（bad_expected_access的基类）
+#include <functional>  // 提供std::invoke
+#include <type_traits> // 提供std::invoke_result_t/is_void_v等
+#include <utility>     // 提供std::move/std::forward/std::in_place_index
+#include <variant>     // 提供std::variant/std::monostate（存储值或错误）
+
+// 放在命名空间err中：避免与std::unexpected（C++17之前的异常规范函数）
+// 以及C++23的std::expected/std::unexpected在using namespace std时冲突
+namespace err
+{
+
+/**
+ * @brief 错误值的包装，用于构造表示失败的expected
+ * 例如：return err::unexpected("bad input");
+ */
+template <typename E>
+class unexpected
+{
+public:
+    explicit unexpected(const E &e) : error_(e) {}
+    explicit unexpected(E &&e) : error_(std::move(e)) {}
+
+    const E &error() const & { return error_; }
+    E &error() & { return error_; }
+    E &&error() && { return std::move(error_); }
+
+private:
+    E error_;
+};
+
+// 推导指引：unexpected("literal")推导为unexpected<const char *>
+template <typename E>
+unexpected(E) -> unexpected<E>;
+
+/**
+ * @brief 在失败的expected上访问值时抛出的异常
+ */
+template <typename E>
+class bad_expected_access : public std::exception
+{
+public:
+    explicit bad_expected_access(E e) : error_(std::move(e)) {}
+    const char *what() const noexcept override { return "bad expected access"; }
+    const E &error() const { return error_; }
+
+private:
+    E error_;
+};
+
+template <typename T, typename E>
+class expected;
+
+template <typename T>
+struct is_expected : std::false_type
+{
+};
+
+template <typename T, typename E>
+struct is_expected<expected<T, E>> : std::true_type
+{
+};
+
+/**
+ * @brief 值或错误
+ * @tparam T 值类型（可以是void）
+ * @tparam E 错误类型
+ */
+template <typename T, typename E>
+class expected
+{
+    // void没有对象，用std::monostate占位
+    using stored_type = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+public:
+    using value_type = T;
+    using error_type = E;
+    using unexpected_type = unexpected<E>;
+
+    /**
+     * @brief 默认构造：持有值初始化的T（T为void时表示成功）
+     */
+    expected() : storage_(std::in_place_index<0>) {}
+
+    /**
+     * @brief 从值构造（成功）
+     */
+    template <typename U = stored_type,
+              typename = std::enable_if_t<
+                  !std::is_void_v<T> &&
+                  std::is_constructible_v<stored_type, U &&> &&
+                  !std::is_same_v<std::decay_t<U>, expected> &&
+                  !std::is_same_v<std::decay_t<U>, std::in_place_t>>>
+    expected(U &&value) : storage_(std::in_place_index<0>, std::forward<U>(value))
+    {
+    }
+
+    /**
+     * @brief 原地构造值
+     */
+    template <typename... Args>
+    explicit expected(std::in_place_t, Args &&...args)
+        : storage_(std::in_place_index<0>, std::forward<Args>(args)...)
+    {
+    }
+
+    /**
+     * @brief 从unexpected构造（失败）
+     */
+    template <typename G>
+    expected(const unexpected<G> &u) : storage_(std::in_place_index<1>, u.error())
+    {
+    }
+
+    template <typename G>
+    expected(unexpected<G> &&u)
+        : storage_(std::in_place_index<1>, std::move(u).error())
+    {
+    }
+
+    bool has_value() const noexcept { return storage_.index() == 0; }
+    explicit operator bool() const noexcept { return has_value(); }
+
+    /**
+     * @brief 访问值（前提：has_value()为true，否则行为未定义）
+     */
+    std::add_lvalue_reference_t<T> operator*() &
+    {
+        if constexpr (!std::is_void_v<T>)
+        {
+            return *std::get_if<0>(&storage_);
+        }
+    }
+
+    std::add_lvalue_reference_t<const T> operator*() const &
+    {
+        if constexpr (!std::is_void_v<T>)
+        {
+            return *std::get_if<0>(&storage_);
+        }
+    }
+
+    std::add_rvalue_reference_t<T> operator*() &&
+    {
+        if constexpr (!std::is_void_v<T>)
+        {
+            return std::move(*std::get_if<0>(&storage_));
+        }
+    }
+
+    std::add_pointer_t<T> operator->() { return std::get_if<0>(&storage_); }
+    std::add_pointer_t<const T> operator->() const
+    {
+        return std::get_if<0>(&storage_);
+    }
+
+    /**
+     * @brief 访问值；失败时抛出bad_expected_access<E>
+     */
+    std::add_lvalue_reference_t<T> value() &
+    {
+        check();
+        return **this;
+    }
+
+    std::add_lvalue_reference_t<const T> value() const &
+    {
+        check();
+        return **this;
+    }
+
+    std::add_rvalue_reference_t<T> value() &&
+    {
+        check();
+        return *std::move(*this);
+    }
+
+    /**
+     * @brief 访问错误（前提：has_value()为false）
+     */
+    E &error() & { return *std::get_if<1>(&storage_); }
+    const E &error() const & { return *std::get_if<1>(&storage_); }
+    E &&error() && { return std::move(*std::get_if<1>(&storage_)); }
+
+    /**
+     * @brief 成功时返回值，失败时返回default_value
+     */
+    template <typename U>
+    stored_type value_or(U &&default_value) const &
+    {
+        return has_value() ? **this
+                           : static_cast<stored_type>(std::forward<U>(default_value));
+    }
+
+    template <typename U>
+    stored_type value_or(U &&default_value) &&
+    {
+        return has_value() ? *std::move(*this)
+                           : static_cast<stored_type>(std::forward<U>(default_value));
+    }
+
+    /**
+     * @brief 成功时以值调用f（f必须返回expected<U, E>），失败时直接传递错误
+     */
+    template <typename F>
+    auto and_then(F &&f) & { return and_then_impl(*this, std::forward<F>(f)); }
+    template <typename F>
+    auto and_then(F &&f) const & { return and_then_impl(*this, std::forward<F>(f)); }
+    template <typename F>
+    auto and_then(F &&f) && { return and_then_impl(std::move(*this), std::forward<F>(f)); }
+
+    /**
+     * @brief 失败时以错误调用f（f必须返回expected<T, G>，可用于恢复或转换错误），成功时直接传递值
+     */
+    template <typename F>
+    auto or_else(F &&f) & { return or_else_impl(*this, std::forward<F>(f)); }
+    template <typename F>
+    auto or_else(F &&f) const & { return or_else_impl(*this, std::forward<F>(f)); }
+    template <typename F>
+    auto or_else(F &&f) && { return or_else_impl(std::move(*this), std::forward<F>(f)); }
+
+    /**
+     * @brief 成功时把值变换为f(值)，结果为expected<U, E>
+     */
+    template <typename F>
+    auto transform(F &&f) & { return transform_impl(*this, std::forward<F>(f)); }
+    template <typename F>
+    auto transform(F &&f) const & { return transform_impl(*this, std::forward<F>(f)); }
+    template <typename F>
+    auto transform(F &&f) && { return transform_impl(std::move(*this), std::forward<F>(f)); }
+
+    /**
+     * @brief 失败时把错误变换为f(错误)，结果为expected<T, G>
+     */
+    template <typename F>
+    auto transform_error(F &&f) & { return transform_error_impl(*this, std::forward<F>(f)); }
+    template <typename F>
+    auto transform_error(F &&f) const & { return transform_error_impl(*this, std::forward<F>(f)); }
+    template <typename F>
+    auto transform_error(F &&f) && { return transform_error_impl(std::move(*this), std::forward<F>(f)); }
+
+private:
+    void check() const
+    {
+        if (!has_value())
+        {
+            throw bad_expected_access<E>(error());
+        }
+    }
+
+    // 以self的值调用f：T为void时不传参数
+    template <typename Self, typename F>
+    static decltype(auto) invoke_with_value(Self &&self, F &&f)
+    {
+        if constexpr (std::is_void_v<T>)
+        {
+            return std::invoke(std::forward<F>(f));
+        }
+        else
+        {
+            return std::invoke(std::forward<F>(f), *std::forward<Self>(self));
+        }
+    }
+
+    // 以下四个辅助函数用Self统一处理左值/const左值/右值三种调用方式
+    template <typename Self, typename F>
+    static auto and_then_impl(Self &&self, F &&f)
+    {
+        using result =
+            std::decay_t<decltype(invoke_with_value(std::forward<Self>(self),
+                                                    std::forward<F>(f)))>;
+        static_assert(is_expected<result>::value,
+                      "and_then: f must return an expected");
+        static_assert(std::is_same_v<typename result::error_type, E>,
+                      "and_then: f must return an expected with the same error type");
+        if (self.has_value())
+        {
+            return invoke_with_value(std::forward<Self>(self), std::forward<F>(f));
+        }
+        return result(unexpected<E>(std::forward<Self>(self).error()));
+    }
+
+    template <typename Self, typename F>
+    static auto or_else_impl(Self &&self, F &&f)
+    {
+        using result = std::decay_t<
+            std::invoke_result_t<F, decltype(std::forward<Self>(self).error())>>;
+        static_assert(is_expected<result>::value,
+                      "or_else: f must return an expected");
+        static_assert(std::is_same_v<typename result::value_type, T>,
+                      "or_else: f must return an expected with the same value type");
+        if (!self.has_value())
+        {
+            return std::invoke(std::forward<F>(f), std::forward<Self>(self).error());
+        }
+        if constexpr (std::is_void_v<T>)
+        {
+            return result();
+        }
+        else
+        {
+            return result(std::in_place, *std::forward<Self>(self));
+        }
+    }
+
+    template <typename Self, typename F>
+    static auto transform_impl(Self &&self, F &&f)
+    {
+        using U = std::remove_cv_t<
+            decltype(invoke_with_value(std::forward<Self>(self), std::forward<F>(f)))>;
+        using result = expected<U, E>;
+        if (!self.has_value())
+        {
+            return result(unexpected<E>(std::forward<Self>(self).error()));
+        }
+        if constexpr (std::is_void_v<U>)
+        {
+            invoke_with_value(std::forward<Self>(self), std::forward<F>(f));
+            return result();
+        }
+        else
+        {
+            return result(std::in_place,
+                          invoke_with_value(std::forward<Self>(self), std::forward<F>(f)));
+        }
+    }
+
+    template <typename Self, typename F>
+    static auto transform_error_impl(Self &&self, F &&f)
+    {
+        using G = std::remove_cv_t<
+            std::invoke_result_t<F, decltype(std::forward<Self>(self).error())>>;
+        using result = expected<T, G>;
+        if (!self.has_value())
+        {
+            return result(unexpected<G>(
+                std::invoke(std::forward<F>(f), std::forward<Self>(self).error())));
+        }
+        if constexpr (std::is_void_v<T>)
+        {
+            return result();
+        }
+        else
+        {
+            return result(std::in_place, *std::forward<Self>(self));
+        }
+    }
+
+    std::variant<stored_type, E> storage_; // 下标0为值，下标1为错误（T与E相同时也能区分）
+};
+
+} // namespace err
+
+// 传播辅助宏：拼接出唯一的临时变量名
+#define EXPECTED_CONCAT_IMPL(a, b) a##b
+#define EXPECTED_CONCAT(a, b) EXPECTED_CONCAT_IMPL(a, b)
+
+/**
+ * @brief EXPECTED_TRY(decl, expr)：计算expr（一个expected），失败时把错误作为当前函数的
+ * 返回值提前返回，成功时用值初始化decl。例如：
+ *     EXPECTED_TRY(int x, parse(text));
+ *     return x * 2;
+ * 当前函数的返回类型必须是错误类型兼容的expected
+ */
+#define EXPECTED_TRY(decl, expr)                                         \
+    auto &&EXPECTED_CONCAT(expected_tmp_, __LINE__) = (expr);            \
+    if (!EXPECTED_CONCAT(expected_tmp_, __LINE__).has_value())           \
+        return ::err::unexpected(                                        \
+            std::move(EXPECTED_CONCAT(expected_tmp_, __LINE__)).error()); \
+    decl = *std::move(EXPECTED_CONCAT(expected_tmp_, __LINE__))
+
+/**
+ * @brief EXPECTED_CHECK(expr)：用于不关心值（或值为void）的expected，失败时提前返回错误
+ */
+#define EXPECTED_CHECK(expr)                                                      \
+    do                                                                            \
+    {                                                                             \
+        auto &&expected_tmp_ = (expr);                                            \
+        if (!expected_tmp_.has_value())                                           \
+            return ::err::unexpected(std::move(expected_tmp_).error());           \
+    } while (0)
+
+#endif // EXPECTED_HPP
@@ -0,0 +1,117 @@
+// 按类型分区的形状容器头文件：替代vector<unique_ptr<Shape>>的批量处理方案
+// 核心特性：
+//   1. shape_collection<Shapes...>为每一种具体形状维护一个独立的连续数组（std::vector<S>），
+//      形状按值存放，不需要逐个new，也没有指向堆上分散对象的指针
+//   2. for_each_shape(f)按类型依次遍历各个数组：每个数组内部是类型确定的紧凑循环，
+//      f(const S&)在编译期就确定了调用哪个重载，可以内联甚至向量化，完全没有虚函数分派
+// 代价：元素的插入顺序只在同一类型内部保留，不同类型之间的先后顺序会丢失
+// 用法：
+//     shape_collection<static_shapes::Circle, static_shapes::Triangle> shapes;
+//     shapes.emplace<static_shapes::Circle>(1.0);
+//     double total = 0;
+//     shapes.for_each_shape([&](const auto &s) { total += s.area(); });
+#ifndef SHAPE_COLLECTION_HPP
+#define SHAPE_COLLECTION_HPP
+
+#include <cstddef>     // 提供size_t
+#include <tuple>       // 提供std::tuple/std::get
+#include <type_traits> // 提供std::decay_t
+#include <utility>     // 提供std::forward
+#include <vector>      // 提供std::vector（每种形状一个数组）
+
+/**
+ * @brief 按类型分区存放形状的容器
+ * @tparam Shapes 所有可能的具体形状类型（互不相同）
+ */
+template <typename... Shapes>
+class shape_collection
+{
+public:
+    /**
+     * @brief 原地构造一个S类型的形状，追加到S的数组末尾
+     */
+    template <typename S, typename... Args>
+    S &emplace(Args &&...args)
+    {
+        return part<S>().emplace_back(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 追加一个形状（类型由参数推导）
+     */
+    template <typename S>
+    void push_back(S &&shape)
+    {
+        part<std::decay_t<S>>().push_back(std::forward<S>(shape));
+    }
+
+    /**
+     * @brief 为S类型预留n个元素的空间
+     */
+    template <typename S>
+    void reserve(size_t n)
+    {
+        part<S>().reserve(n);
+    }
+
+    /**
+     * @brief 访问S类型的数组
+     */
+    template <typename S>
+    const std::vector<S> &get() const
+    {
+        return std::get<std::vector<S>>(parts_);
+    }
+
+    /**
+     * @brief 所有形状的个数
+     */
+    size_t size() const
+    {
+        return (std::get<std::vector<Shapes>>(parts_).size() + ... + 0);
+    }
+
+    bool empty() const { return size() == 0; }
+
+    void clear()
+    {
+        (std::get<std::vector<Shapes>>(parts_).clear(), ...);
+    }
+
+    /**
+     * @brief 访问者：按Shapes的顺序逐个类型遍历，对每个形状调用f(const S&)
+     * f通常是泛型lambda，或为每种形状提供重载的函数对象
+     */
+    template <typename F>
+    void for_each_shape(F &&f) const
+    {
+        (for_each_in(std::get<std::vector<Shapes>>(parts_), f), ...);
+    }
+
+    template <typename F>
+    void for_each_shape(F &&f)
+    {
+        (for_each_in(std::get<std::vector<Shapes>>(parts_), f), ...);
+    }
+
+private:
+    template <typename S>
+    std::vector<S> &part()
+    {
+        return std::get<std::vector<S>>(parts_);
+    }
+
+    // 单一类型的紧凑循环
+    template <typename Vec, typename F>
+    static void for_each_in(Vec &shapes, F &f)
+    {
+        for (auto &s : shapes)
+        {
+            f(s);
+        }
+    }
+
+    std::tuple<std::vector<Shapes>...> parts_; // 每种形状一个连续数组
+};
+
+#endif // SHAPE_COLLECTION_HPP
@@ -0,0 +1,131 @@
+// 形状处理的三种分派方式头文件：对应temporary_object.cpp中的process_shape(Circle(), Triangle())
+// 核心特性：
+//   1. dynamic_shapes：与temporary_object.cpp相同的虚函数继承体系，
+//      process_shape通过const Shape&接收形状，每次求面积都经过虚函数表
+//   2. static_shapes::shape：std::variant<Circle, Triangle>，形状按值存放（无堆分配），
+//      process_shape用std::visit按类型下标分派，编译器可以内联每种形状的area()
+//   3. static_shapes::shape_base<Derived>：CRTP静态多态，调用时类型已知，完全没有运行时分派
+// 为了有可测量的工作量，形状带有尺寸，process_shape返回两个形状的面积之和（Result为普通值类型）
+#ifndef SHAPE_DISPATCH_HPP
+#define SHAPE_DISPATCH_HPP
+
+#include <variant> // 提供std::variant/std::visit
+
+// 处理形状后的结果：普通值类型，返回时不涉及任何分配
+struct Result
+{
+    double area;
+};
+
+namespace dynamic_shapes
+{
+
+// 形状基类：与temporary_object.cpp相同，通过虚函数实现多态
+class Shape
+{
+public:
+    virtual ~Shape() {}
+    virtual double area() const = 0;
+};
+
+class Circle : public Shape
+{
+public:
+    explicit Circle(double radius = 1.0) : radius_(radius) {}
+    double area() const override { return 3.14159265358979 * radius_ * radius_; }
+
+private:
+    double radius_;
+};
+
+class Triangle : public Shape
+{
+public:
+    explicit Triangle(double base = 1.0, double height = 1.0)
+        : base_(base), height_(height)
+    {
+    }
+    double area() const override { return 0.5 * base_ * height_; }
+
+private:
+    double base_;
+    double height_;
+};
+
+// 每个形状的面积都要经过一次虚函数调用
+inline Result process_shape(const Shape &shape1, const Shape &shape2)
+{
+    return Result{shape1.area() + shape2.area()};
+}
+
+} // namespace dynamic_shapes
+
+namespace static_shapes
+{
+
+/**
+ * @brief CRTP基类：area()在编译期转发给派生类的area_impl()，不需要虚函数表
+ * @tparam Derived 派生类（Circle或Triangle）
+ */
+template <typename Derived>
+class shape_base
+{
+public:
+    double area() const { return static_cast<const Derived &>(*this).area_impl(); }
+
+protected:
+    shape_base() = default; // 只能作为基类使用
+};
+
+class Circle : public shape_base<Circle>
+{
+public:
+    explicit Circle(double radius = 1.0) : radius_(radius) {}
+    double area_impl() const { return 3.14159265358979 * radius_ * radius_; }
+
+private:
+    double radius_;
+};
+
+class Triangle : public shape_base<Triangle>
+{
+public:
+    explicit Triangle(double base = 1.0, double height = 1.0)
+        : base_(base), height_(height)
+    {
+    }
+    double area_impl() const { return 0.5 * base_ * height_; }
+
+private:
+    double base_;
+    double height_;
+};
+
+// 按值存放的形状：大小为最大的形状加上类型下标，可以直接放进vector，不需要unique_ptr
+using shape = std::variant<Circle, Triangle>;
+
+/**
+ * @brief CRTP版本：两个形状的具体类型在编译期已知（如process_shape(Circle(), Triangle())）
+ */
+template <typename S1, typename S2>
+Result process_shape(const shape_base<S1> &shape1, const shape_base<S2> &shape2)
+{
+    return Result{shape1.area() + shape2.area()};
+}
+
+/**
+ * @brief variant版本：类型在运行时才知道，std::visit按类型下标跳转到内联后的area()
+ */
+inline double area(const shape &s)
+{
+    return std::visit([](const auto &concrete) { return concrete.area(); }, s);
+}
+
+inline Result process_shape(const shape &shape1, const shape &shape2)
+{
+    return Result{area(shape1) + area(shape2)};
+}
+
+} // namespace static_shapes
+
+#endif // SHAPE_DISPATCH_HPP
@@ -0,0 +1,74 @@
+// To compile: g++ -std=c++17 -o stack_unwind_expected stack_unwind_expected.cpp
+// To run:     ./stack_unwind_expected
+
+#include <stdio.h>
+#include "expected.hpp"
+
+using err::expected;
+using err::unexpected;
+
+// 与stack_unwind.cpp中的Obj相同，用于观察对象的构造与析构过程
+class Obj
+{
+public:
+    Obj() { puts("Obj()"); }
+    ~Obj() { puts("~Obj()"); }
+};
+
+// stack_unwind.cpp中foo的expected版本：n为42时不抛异常，而是返回错误
+// 返回类型expected<void, const char *>：成功时没有值，失败时带一个错误信息
+expected<void, const char *> foo(int n)
+{
+    Obj obj; // 无论成功还是失败，obj都在函数返回时正常析构（普通返回，不需要栈展开）
+    if (n == 42)
+    {
+        return unexpected("life, the universe and everything");
+    }
+    return {};
+}
+
+// 调用链中间的一层：用EXPECTED_CHECK把foo的错误原样向上传递（相当于不捕获异常）
+expected<int, const char *> bar(int n)
+{
+    Obj obj;
+    EXPECTED_CHECK(foo(n)); // 失败时bar提前返回，obj照常析构
+    return n * 2;
+}
+
+int main()
+{
+    // 1. 与stack_unwind.cpp的try块对应：逐个调用，检查返回值代替catch
+    if (auto r = foo(41); !r)
+    {
+        puts(r.error());
+    }
+    if (auto r = foo(42); !r)
+    {
+        puts(r.error()); // 输出"life, the universe and everything"
+    }
+
+    // 2. 错误穿过中间层bar传递到这里
+    puts("--- bar(42)");
+    auto r = bar(42);
+    printf("has_value = %d, error = %s\n", r.has_value(), r.error());
+
+    // 3. 单子式组合：and_then只在成功时继续，or_else只在失败时执行
+    puts("--- bar(20).and_then(...)");
+    auto chained = bar(20)
+                       .and_then([](int v) { return bar(v + 2); }) // bar(42)失败
+                       .transform([](int v) { return v + 1; })     // 被跳过
+                       .or_else([](const char *err) {
+                           printf("recovering from: %s\n", err);
+                           return expected<int, const char *>(-1); // 用默认值恢复
+                       });
+    printf("result = %d\n", *chained);
+    return 0;
+}
+
+/*
+ * 与异常的对比：
+ * - throw：失败时运行时查表找到catch，逐帧展开并调用析构函数；成功路径几乎零开销，
+ *   但失败路径通常要慢上几个数量级（见extension/expected_benchmark.cpp）
+ * - expected：失败只是一次普通的返回，每一层都多一次分支检查；
+ *   失败率越高、调用链越短，expected越划算
+ */
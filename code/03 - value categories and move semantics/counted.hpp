@@ -0,0 +1,187 @@
+// 特殊成员函数计数器头文件：统计某个类型的构造、拷贝、移动、赋值与析构次数
+// 核心特性：
+//   1. counted<Tag>：作为基类混入（mixin）。派生类的特殊成员函数（无论是编译器生成的
+//      还是手写的）都会调用基类对应的版本，计数由基类完成，派生类不需要任何输出语句
+//   2. counted_value<T>：包装任意类型T，用于统计容器中元素的拷贝/移动次数
+//   3. 默认使用线程局部计数器（无锁、无I/O，适合在基准测试中使用）；
+//      对象会在线程之间传递时，使用counted<Tag, true>改为原子计数器
+// 注意：派生类手写拷贝/移动构造函数时，要在初始化列表中显式调用基类的拷贝/移动构造，
+//       否则基类会被默认构造，计入constructs而不是copy_constructs/move_constructs
+#ifndef COUNTED_HPP
+#define COUNTED_HPP
+
+#include <atomic>           // 提供std::atomic（原子计数器）
+#include <cstddef>          // 提供size_t
+#include <initializer_list> // 提供std::initializer_list（reset中遍历成员指针）
+#include <type_traits>      // 提供std::conditional_t
+#include <utility>          // 提供std::forward/std::in_place_t
+
+/**
+ * @brief 计数结果（某一时刻的快照）
+ */
+struct object_counts
+{
+    size_t constructs = 0;       // 除拷贝/移动以外的构造（包括默认构造和带参构造）
+    size_t copy_constructs = 0;  // 拷贝构造
+    size_t move_constructs = 0;  // 移动构造
+    size_t copy_assignments = 0; // 拷贝赋值
+    size_t move_assignments = 0; // 移动赋值
+    size_t destructions = 0;     // 析构
+
+    // 当前存活的对象个数
+    size_t alive() const
+    {
+        return constructs + copy_constructs + move_constructs - destructions;
+    }
+
+    bool operator==(const object_counts &rhs) const
+    {
+        return constructs == rhs.constructs &&
+               copy_constructs == rhs.copy_constructs &&
+               move_constructs == rhs.move_constructs &&
+               copy_assignments == rhs.copy_assignments &&
+               move_assignments == rhs.move_assignments &&
+               destructions == rhs.destructions;
+    }
+    bool operator!=(const object_counts &rhs) const { return !(*this == rhs); }
+};
+
+/**
+ * @brief 计数器混入基类
+ * @tparam Tag 区分计数器的类型（通常就是派生类自身，即CRTP用法）
+ * @tparam Atomic 为true时使用全局原子计数器，否则使用线程局部计数器
+ */
+template <typename Tag, bool Atomic = false>
+class counted
+{
+public:
+    counted() { bump(&storage::constructs); }
+    counted(const counted &) { bump(&storage::copy_constructs); }
+    counted(counted &&) noexcept { bump(&storage::move_constructs); }
+    ~counted() { bump(&storage::destructions); }
+
+    counted &operator=(const counted &)
+    {
+        bump(&storage::copy_assignments);
+        return *this;
+    }
+
+    counted &operator=(counted &&) noexcept
+    {
+        bump(&storage::move_assignments);
+        return *this;
+    }
+
+    /**
+     * @brief 读取当前计数（线程局部计数器只包含当前线程的操作）
+     */
+    static object_counts counts()
+    {
+        const storage &s = get();
+        object_counts result;
+        result.constructs = load(s.constructs);
+        result.copy_constructs = load(s.copy_constructs);
+        result.move_constructs = load(s.move_constructs);
+        result.copy_assignments = load(s.copy_assignments);
+        result.move_assignments = load(s.move_assignments);
+        result.destructions = load(s.destructions);
+        return result;
+    }
+
+    /**
+     * @brief 把所有计数清零
+     */
+    static void reset()
+    {
+        storage &s = get();
+        for (auto member : {&storage::constructs, &storage::copy_constructs,
+                            &storage::move_constructs, &storage::copy_assignments,
+                            &storage::move_assignments, &storage::destructions})
+        {
+            store_zero(s.*member);
+        }
+    }
+
+private:
+    using counter = std::conditional_t<Atomic, std::atomic<size_t>, size_t>;
+
+    struct storage
+    {
+        counter constructs{0};
+        counter copy_constructs{0};
+        counter move_constructs{0};
+        counter copy_assignments{0};
+        counter move_assignments{0};
+        counter destructions{0};
+    };
+
+    static storage &get()
+    {
+        if constexpr (Atomic)
+        {
+            static storage s;
+            return s;
+        }
+        else
+        {
+            thread_local storage s;
+            return s;
+        }
+    }
+
+    static void bump(counter storage::*member)
+    {
+        if constexpr (Atomic)
+        {
+            (get().*member).fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            ++(get().*member);
+        }
+    }
+
+    static size_t load(const counter &c)
+    {
+        if constexpr (Atomic)
+        {
+            return c.load(std::memory_order_relaxed);
+        }
+        else
+        {
+            return c;
+        }
+    }
+
+    static void store_zero(counter &c)
+    {
+        if constexpr (Atomic)
+        {
+            c.store(0, std::memory_order_relaxed);
+        }
+        else
+        {
+            c = 0;
+        }
+    }
+};
+
+/**
+ * @brief 带计数的包装类型：持有一个T，特殊成员函数由编译器生成（因而会调用counted的版本）
+ * 例如用vector<counted_value<string>>检查容器扩容时是否拷贝了元素
+ */
+template <typename T, bool Atomic = false>
+struct counted_value : counted<counted_value<T, Atomic>, Atomic>
+{
+    T value;
+
+    counted_value() = default;
+
+    template <typename... Args>
+    explicit counted_value(std::in_place_t, Args &&...args)
+        : value(std::forward<Args>(args)...)
+    {
+    }
+};
+
+#endif // COUNTED_HPP
@@ -0,0 +1,201 @@
+// To compile: g++ -std=c++17 -o rvo_counts rvo_counts.cpp
+//             g++ -std=c++17 -DDISABLE_MOVE -o rvo_counts_nomove rvo_counts.cpp
+// To run:     ./rvo_counts && ./rvo_counts_nomove
+
+// 程序功能：rvo.cpp的可自动检查版本。A不再打印，而是通过counted<A>统计特殊成员函数的调用次数，
+//           程序逐个检查每个getA_*函数（两个分支）的精确计数，以及vector扩容时是否拷贝了元素；
+//           全部符合预期时返回0，否则打印差异并返回1，可直接在CI中运行
+// 说明：期望值基于C++17（无名临时对象的复制消除是强制的）以及GCC/Clang总会执行的NRVO；
+//       使用-fno-elide-constructors编译时，getA_named_rvo会多出一次移动（或拷贝）
+#include <iostream> // 提供输出功能（只用于报告检查结果）
+#include <utility>  // 提供std::move
+#include <vector>   // 提供std::vector（检查容器扩容）
+#include "counted.hpp"
+
+using namespace std;
+
+bool cond = false;
+
+// 与rvo.cpp中的A相同，只是把输出语句换成了计数
+class A : public counted<A>
+{
+public:
+    A(int num = 0) : num_{num} {}
+
+    A(const A &rhs) : counted<A>(rhs), num_{rhs.num_} {}
+
+    A &operator=(const A &rhs)
+    {
+        counted<A>::operator=(rhs);
+        num_ = rhs.num_;
+        return *this;
+    }
+
+#ifndef DISABLE_MOVE
+    A(A &&rhs) noexcept : counted<A>(std::move(rhs)), num_(rhs.num_)
+    {
+        rhs.num_ = -1;
+    }
+
+    A &operator=(A &&rhs) noexcept
+    {
+        counted<A>::operator=(std::move(rhs));
+        num_ = rhs.num_;
+        rhs.num_ = -1;
+        return *this;
+    }
+#endif
+
+    int num() const { return num_; }
+
+private:
+    int num_;
+};
+
+A getA_unnamed_rvo()
+{
+    return A();
+}
+
+A getA_named_rvo()
+{
+    A a;
+    return a;
+}
+
+A getA_named_rvo_suppressed()
+{
+    A a;
+    return std::move(a); // 故意抑制NRVO（编译器会给出-Wpessimizing-move警告）
+}
+
+A getA_no_rvo1()
+{
+    A a(1);
+    if (cond)
+    {
+        return A();
+    }
+    else
+    {
+        return a;
+    }
+}
+
+A getA_no_rvo2()
+{
+    A a1(1);
+    A a2(2);
+    if (cond)
+    {
+        return a1;
+    }
+    else
+    {
+        return a2;
+    }
+}
+
+// 返回对象时的一次“转移”：有移动构造时是移动，DISABLE_MOVE时退化为拷贝
+#ifndef DISABLE_MOVE
+constexpr size_t copies_per_transfer = 0;
+constexpr size_t moves_per_transfer = 1;
+#else
+constexpr size_t copies_per_transfer = 1;
+constexpr size_t moves_per_transfer = 0;
+#endif
+
+/**
+ * @brief 构造期望的计数：constructs次普通构造 + transfers次转移，所有对象最终都被析构
+ */
+object_counts expected(size_t constructs, size_t transfers)
+{
+    object_counts c;
+    c.constructs = constructs;
+    c.copy_constructs = transfers * copies_per_transfer;
+    c.move_constructs = transfers * moves_per_transfer;
+    c.destructions = constructs + transfers;
+    return c;
+}
+
+ostream &operator<<(ostream &os, const object_counts &c)
+{
+    return os << "construct=" << c.constructs << " copy=" << c.copy_constructs
+              << " move=" << c.move_constructs << " copy==" << c.copy_assignments
+              << " move==" << c.move_assignments << " destroy=" << c.destructions;
+}
+
+int failures = 0;
+
+/**
+ * @brief 调用fn，在接收结果的对象析构后检查计数
+ */
+template <typename Fn>
+void check(const char *name, bool branch, Fn fn, const object_counts &want)
+{
+    cond = branch;
+    A::reset();
+    {
+        A a = fn();
+        (void)a;
+    }
+    object_counts got = A::counts();
+    bool ok = got == want;
+    cout << (ok ? "[ OK ] " : "[FAIL] ") << name << " (cond=" << branch << ")  "
+         << got;
+    if (!ok)
+    {
+        cout << "\n       期望: " << want;
+        ++failures;
+    }
+    cout << '\n';
+}
+
+int main()
+{
+#ifdef DISABLE_MOVE
+    cout << "*** DISABLE_MOVE：转移退化为拷贝\n";
+#else
+    cout << "*** 启用移动语义\n";
+#endif
+    for (bool branch : {false, true})
+    {
+        // 无名临时对象：强制复制消除，只有一次构造
+        check("getA_unnamed_rvo", branch, getA_unnamed_rvo, expected(1, 0));
+        // 具名对象：NRVO，只有一次构造
+        check("getA_named_rvo", branch, getA_named_rvo, expected(1, 0));
+        // std::move阻止了NRVO：一次构造 + 一次转移
+        check("getA_named_rvo_suppressed", branch, getA_named_rvo_suppressed,
+              expected(1, 1));
+        // cond为false：返回a，一次转移；cond为true：A()直接构造在返回值上，a只是局部对象
+        check("getA_no_rvo1", branch, getA_no_rvo1,
+              branch ? expected(2, 0) : expected(1, 1));
+        // 无论返回a1还是a2，都需要一次转移
+        check("getA_no_rvo2", branch, getA_no_rvo2, expected(2, 1));
+    }
+
+    // 容器扩容：移动构造为noexcept时，vector扩容应当移动而不是拷贝旧元素
+    {
+        A::reset();
+        {
+            vector<A> v;
+            for (int i = 0; i < 100; ++i)
+            {
+                v.emplace_back(i);
+            }
+        }
+        object_counts got = A::counts();
+        // 扩容时搬运旧元素只应使用“转移”的那一种方式
+        size_t wrong_kind = moves_per_transfer != 0 ? got.copy_constructs
+                                                    : got.move_constructs;
+        bool ok = got.constructs == 100 && wrong_kind == 0 && got.alive() == 0;
+        cout << (ok ? "[ OK ] " : "[FAIL] ") << "vector<A>扩容  " << got << '\n';
+        if (!ok)
+        {
+            ++failures;
+        }
+    }
+
+    cout << (failures == 0 ? "所有检查通过\n" : "存在不符合预期的计数\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,368 @@
+// 带执行策略的通用遍历头文件：iteration_unified_98.cpp中foo()的实用版本
+// 背景：foo()借助traits<T>统一了标准容器与C数组的遍历方式，但循环体为空；
+//       实际使用时需要对每个元素做点什么（求和、变换），并且希望能向量化或多线程执行
+// 核心特性：
+//   1. traversal::traits<T>：与iteration_unified_98.cpp相同的模式，为容器和C数组提供begin/end，
+//      另外提供可修改元素的版本，并判断元素是否连续存放（vector/array/C数组）
+//   2. 三种执行策略（与std::execution的seq/unseq/par对应）：
+//      - traversal::seq：普通的顺序循环
+//      - traversal::unseq：允许向量化；连续存放时用指针循环并以#pragma GCC ivdep告知编译器没有循环依赖，
+//        reduce使用多个独立的部分和（要求op满足结合律和交换律，与std::reduce相同）
+//      - traversal::par：把范围切成块，由多个线程领取执行，块内按unseq处理；
+//        可指定线程数与块大小，如traversal::par.with(4, 1 << 16)；默认每次调用都创建并回收线程，
+//        traversal::par.on(pool)改为在thread_pool（第16章thread_pool.hpp）中执行，省去创建线程的开销
+//      非随机访问的范围（如list）总是顺序执行
+//   3. traversal::for_each(policy, c, f)：对每个元素调用f(element)（元素可修改）；
+//      traversal::reduce(policy, c, init, op)：归约
+// 用法：
+//     int a[1000];
+//     traversal::for_each(traversal::unseq, a, [](int &x) { x = x * 3 + 1; });
+//     long total = traversal::reduce(traversal::par, v, 0L, std::plus<>());
+//     thread_pool pool;
+//     traversal::for_each(traversal::par.on(pool), v, [](int &x) { ++x; });
+#ifndef TRAVERSE_HPP
+#define TRAVERSE_HPP
+
+#include <algorithm>   // 提供std::min/max
+#include <atomic>      // 提供std::atomic（线程领取块的计数器）
+#include <cstddef>     // 提供size_t
+#include <exception>   // 提供std::exception_ptr
+#include <iterator>    // 提供iterator_traits/random_access_iterator_tag
+#include <mutex>       // 提供std::mutex（合并各线程的部分结果）
+#include <thread>      // 提供std::thread
+#include <type_traits> // 提供std::is_base_of_v等
+#include <utility>     // 提供std::declval
+#include <vector>      // 提供std::vector（工作线程）
+#include "../16 - concurrency programming/thread_pool.hpp"
+
+namespace traversal
+{
+
+/**
+ * @brief 通用traits：通过容器自身的begin()/end()遍历
+ */
+template <typename T>
+struct traits
+{
+    typedef typename T::iterator iterator;
+    typedef typename T::const_iterator const_iterator;
+
+    static iterator begin(T &c) { return c.begin(); }
+    static iterator end(T &c) { return c.end(); }
+    static const_iterator begin(const T &c) { return c.begin(); }
+    static const_iterator end(const T &c) { return c.end(); }
+
+    // 元素是否连续存放（有data()成员且迭代器可随机访问，如vector、array、string）
+    template <typename U>
+    static auto has_data(int) -> decltype(std::declval<U &>().data(), std::true_type());
+    template <typename U>
+    static std::false_type has_data(...);
+
+    static constexpr bool contiguous =
+        decltype(has_data<T>(0))::value &&
+        std::is_base_of_v<std::random_access_iterator_tag,
+                          typename std::iterator_traits<iterator>::iterator_category>;
+};
+
+/**
+ * @brief C风格固定大小数组的特化：用指针作为迭代器
+ */
+template <typename T, size_t N>
+struct traits<T[N]>
+{
+    typedef T *iterator;
+    typedef const T *const_iterator;
+
+    static iterator begin(T (&a)[N]) { return a; }
+    static iterator end(T (&a)[N]) { return a + N; }
+    static const_iterator begin(const T (&a)[N]) { return a; }
+    static const_iterator end(const T (&a)[N]) { return a + N; }
+
+    static constexpr bool contiguous = true;
+};
+
+// ===== 执行策略 =====
+struct sequenced_policy
+{
+};
+
+struct unsequenced_policy
+{
+};
+
+struct parallel_policy
+{
+    unsigned threads = 0;        // 线程数，0表示std::thread::hardware_concurrency()
+    size_t chunk_size = 65536;   // 每块的元素个数
+    thread_pool *pool = nullptr; // 非空时由线程池执行（忽略threads）
+
+    constexpr parallel_policy with(unsigned n, size_t chunk = 65536) const
+    {
+        return parallel_policy{n, chunk, nullptr};
+    }
+
+    constexpr parallel_policy on(thread_pool &p, size_t chunk = 65536) const
+    {
+        return parallel_policy{0, chunk, &p};
+    }
+};
+
+inline constexpr sequenced_policy seq{};
+inline constexpr unsequenced_policy unseq{};
+inline constexpr parallel_policy par{};
+
+namespace detail
+{
+
+template <typename C>
+using traits_of = traits<std::remove_const_t<C>>;
+
+template <typename It>
+constexpr bool is_random_access_v =
+    std::is_base_of_v<std::random_access_iterator_tag,
+                      typename std::iterator_traits<It>::iterator_category>;
+
+constexpr size_t lanes = 8; // unseq归约的部分和个数
+
+// ===== 区段上的循环：It是迭代器，连续存放时是指针 =====
+template <typename It, typename F>
+void seq_for_each(It first, It last, F &f)
+{
+    for (; first != last; ++first)
+    {
+        f(*first);
+    }
+}
+
+template <typename T, typename F>
+void unseq_for_each(T *first, T *last, F &f)
+{
+    const size_t n = static_cast<size_t>(last - first);
+#pragma GCC ivdep
+    for (size_t i = 0; i < n; ++i)
+    {
+        f(first[i]);
+    }
+}
+
+template <typename It, typename T, typename Op>
+T seq_reduce(It first, It last, T init, Op &op)
+{
+    for (; first != last; ++first)
+    {
+        init = op(init, *first);
+    }
+    return init;
+}
+
+// 8个独立的部分和，最后合并：打破循环依赖，编译器可以把它们放进一个SIMD寄存器
+template <typename E, typename T, typename Op>
+T unseq_reduce(E *first, E *last, T init, Op &op)
+{
+    const size_t n = static_cast<size_t>(last - first);
+    if (n < lanes)
+    {
+        return seq_reduce(first, last, init, op);
+    }
+    T acc[lanes];
+    for (size_t k = 0; k < lanes; ++k)
+    {
+        acc[k] = static_cast<T>(first[k]);
+    }
+    size_t i = lanes;
+    for (; i + lanes <= n; i += lanes)
+    {
+        for (size_t k = 0; k < lanes; ++k)
+        {
+            acc[k] = op(acc[k], first[i + k]);
+        }
+    }
+    for (size_t k = 0; k < lanes; ++k)
+    {
+        init = op(init, acc[k]);
+    }
+    return seq_reduce(first + i, last, init, op);
+}
+
+/**
+ * @brief 把[0, n)切成大小为chunk的块，由threads个线程（包括调用线程）领取，对每块调用body(begin, end)；
+ * 指定了线程池时改由pool->parallel_for执行，每块一个下标
+ * body中抛出的第一个异常在所有线程结束后重新抛出
+ */
+template <typename Body>
+void run_chunks(size_t n, const parallel_policy &policy, Body body)
+{
+    const size_t chunk = std::max<size_t>(policy.chunk_size, 1);
+    const size_t chunks = (n + chunk - 1) / chunk;
+    if (policy.pool != nullptr)
+    {
+        policy.pool->parallel_for(0, chunks, 1, [&](size_t c) { body(c * chunk, std::min(n, (c + 1) * chunk)); });
+        return;
+    }
+    unsigned threads = policy.threads != 0 ? policy.threads
+                                           : std::max(1U, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<size_t>(threads, chunks));
+
+    std::atomic<size_t> next{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto work = [&] {
+        try
+        {
+            for (size_t c; (c = next.fetch_add(1, std::memory_order_relaxed)) < chunks;)
+            {
+                body(c * chunk, std::min(n, (c + 1) * chunk));
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error)
+            {
+                error = std::current_exception();
+            }
+            next.store(chunks); // 其余线程不再领取新块
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; ++t)
+    {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto &w : workers)
+    {
+        w.join();
+    }
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief 顺序地对c的每个元素调用f
+ */
+template <typename C, typename F>
+void for_each(sequenced_policy, C &c, F f)
+{
+    detail::seq_for_each(detail::traits_of<C>::begin(c), detail::traits_of<C>::end(c), f);
+}
+
+/**
+ * @brief 允许向量化地对c的每个元素调用f（f不能依赖元素的处理顺序）
+ */
+template <typename C, typename F>
+void for_each(unsequenced_policy, C &c, F f)
+{
+    auto first = detail::traits_of<C>::begin(c);
+    auto last = detail::traits_of<C>::end(c);
+    if constexpr (detail::traits_of<C>::contiguous)
+    {
+        if (first != last)
+        {
+            detail::unseq_for_each(&*first, &*first + (last - first), f);
+        }
+    }
+    else
+    {
+        detail::seq_for_each(first, last, f);
+    }
+}
+
+/**
+ * @brief 多线程分块地对c的每个元素调用f（f可能被多个线程同时调用）
+ */
+template <typename C, typename F>
+void for_each(const parallel_policy &policy, C &c, F f)
+{
+    auto first = detail::traits_of<C>::begin(c);
+    auto last = detail::traits_of<C>::end(c);
+    if constexpr (detail::is_random_access_v<decltype(first)>)
+    {
+        detail::run_chunks(static_cast<size_t>(last - first), policy, [&](size_t b, size_t e) {
+            if constexpr (detail::traits_of<C>::contiguous)
+            {
+                detail::unseq_for_each(&first[b], &first[b] + (e - b), f);
+            }
+            else
+            {
+                detail::seq_for_each(first + b, first + e, f);
+            }
+        });
+    }
+    else
+    {
+        detail::seq_for_each(first, last, f);
+    }
+}
+
+/**
+ * @brief 顺序归约：((init op e0) op e1) op ...
+ */
+template <typename C, typename T, typename Op>
+T reduce(sequenced_policy, const C &c, T init, Op op)
+{
+    return detail::seq_reduce(detail::traits_of<C>::begin(c), detail::traits_of<C>::end(c), init, op);
+}
+
+/**
+ * @brief 允许向量化的归约（op须满足结合律和交换律）
+ */
+template <typename C, typename T, typename Op>
+T reduce(unsequenced_policy, const C &c, T init, Op op)
+{
+    auto first = detail::traits_of<C>::begin(c);
+    auto last = detail::traits_of<C>::end(c);
+    if constexpr (detail::traits_of<C>::contiguous)
+    {
+        if (first == last)
+        {
+            return init;
+        }
+        return detail::unseq_reduce(&*first, &*first + (last - first), init, op);
+    }
+    else
+    {
+        return detail::seq_reduce(first, last, init, op);
+    }
+}
+
+/**
+ * @brief 多线程分块归约：每块得到一个部分结果，最后按任意顺序合并（op须满足结合律和交换律）
+ */
+template <typename C, typename T, typename Op>
+T reduce(const parallel_policy &policy, const C &c, T init, Op op)
+{
+    auto first = detail::traits_of<C>::begin(c);
+    auto last = detail::traits_of<C>::end(c);
+    if constexpr (detail::is_random_access_v<decltype(first)>)
+    {
+        std::mutex m;
+        detail::run_chunks(static_cast<size_t>(last - first), policy, [&](size_t b, size_t e) {
+            T part;
+            if constexpr (detail::traits_of<C>::contiguous)
+            {
+                part = detail::unseq_reduce(&first[b] + 1, &first[b] + (e - b), static_cast<T>(first[b]), op);
+            }
+            else
+            {
+                part = detail::seq_reduce(first + b + 1, first + e, static_cast<T>(first[b]), op);
+            }
+            std::lock_guard<std::mutex> lock(m);
+            init = op(init, part);
+        });
+        return init;
+    }
+    else
+    {
+        return detail::seq_reduce(first, last, init, op);
+    }
+}
+
+} // namespace traversal
+
+#endif // TRAVERSE_HPP
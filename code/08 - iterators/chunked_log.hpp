@@ -0,0 +1,250 @@
+// 分段追加日志容器头文件：适合“只在末尾追加、经常从后往前扫描”的大日志（reverse_iterate.cpp中reverseOutput的负载）
+// 背景：vector增长时需要重新分配并搬动全部元素，已取得的引用/指针随之失效；
+//       deque不搬动元素，但每次++/--都要判断是否跨越了内部的小块（libstdc++中每块仅512字节），
+//       逐元素反向遍历的开销大，编译器也无法向量化
+// 核心特性：
+//   1. chunked_log<T, ChunkSize>：元素存放在若干个连续的块中，每块ChunkSize个元素（默认约64KB），
+//      块一旦分配就不再移动，push_back之后已有元素的引用和指针始终有效
+//   2. 随机访问迭代器（begin/end、rbegin/rend），可直接交给reverseOutput和标准算法；
+//      ChunkSize是2的幂，下标到（块，块内位置）的换算只是移位和按位与；
+//      与deque相同，追加元素可能使迭代器失效（块指针表会重新分配），但不会使引用失效
+//   3. for_each_chunk/for_each_chunk_reverse：按块遍历，回调收到一段连续的[first, last)，
+//      块内是普通的指针循环，编译器可以向量化；for_each_reverse在此基础上逐元素反向遍历
+#ifndef CHUNKED_LOG_HPP
+#define CHUNKED_LOG_HPP
+
+#include <cstddef>     // 提供size_t/ptrdiff_t
+#include <iterator>    // 提供random_access_iterator_tag/reverse_iterator
+#include <new>         // 提供operator new(size_t, align_val_t)/placement new
+#include <type_traits> // 提供std::conditional_t
+#include <utility>     // 提供std::forward
+#include <vector>      // 提供std::vector（块指针表）
+
+// 默认块大小：约64KB，至少一个元素，向下取为2的幂
+template <typename T>
+constexpr size_t default_chunk_size()
+{
+    size_t n = 1;
+    while (n * 2 * sizeof(T) <= 64 * 1024)
+    {
+        n *= 2;
+    }
+    return n;
+}
+
+/**
+ * @brief 分段存储、只在末尾追加的容器
+ * @tparam T 元素类型
+ * @tparam ChunkSize 每块的元素个数（必须是2的幂）
+ */
+template <typename T, size_t ChunkSize = default_chunk_size<T>()>
+class chunked_log
+{
+    static_assert(ChunkSize != 0 && (ChunkSize & (ChunkSize - 1)) == 0,
+                  "ChunkSize must be a power of two");
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+
+    static constexpr size_t chunk_size = ChunkSize;
+    static constexpr size_t alignment = alignof(T) > 64 ? alignof(T) : 64; // 块按缓存行对齐
+
+    template <bool Const>
+    class basic_iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T *, T *>;
+        using reference = std::conditional_t<Const, const T &, T &>;
+
+        basic_iterator() = default;
+        basic_iterator(T *const *chunks, size_t index) : chunks_(chunks), index_(index) {}
+
+        // 允许iterator转换为const_iterator
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        basic_iterator(const basic_iterator<false> &other)
+            : chunks_(other.chunks_), index_(other.index_)
+        {
+        }
+
+        reference operator*() const { return chunks_[index_ / ChunkSize][index_ % ChunkSize]; }
+        pointer operator->() const { return &**this; }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        basic_iterator &operator++() { ++index_; return *this; }
+        basic_iterator &operator--() { --index_; return *this; }
+        basic_iterator operator++(int) { basic_iterator tmp = *this; ++index_; return tmp; }
+        basic_iterator operator--(int) { basic_iterator tmp = *this; --index_; return tmp; }
+        basic_iterator &operator+=(difference_type n) { index_ += n; return *this; }
+        basic_iterator &operator-=(difference_type n) { index_ -= n; return *this; }
+
+        friend basic_iterator operator+(basic_iterator it, difference_type n) { return it += n; }
+        friend basic_iterator operator+(difference_type n, basic_iterator it) { return it += n; }
+        friend basic_iterator operator-(basic_iterator it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const basic_iterator &a, const basic_iterator &b)
+        {
+            return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
+        }
+
+        friend bool operator==(const basic_iterator &a, const basic_iterator &b) { return a.index_ == b.index_; }
+        friend bool operator!=(const basic_iterator &a, const basic_iterator &b) { return a.index_ != b.index_; }
+        friend bool operator<(const basic_iterator &a, const basic_iterator &b) { return a.index_ < b.index_; }
+        friend bool operator>(const basic_iterator &a, const basic_iterator &b) { return a.index_ > b.index_; }
+        friend bool operator<=(const basic_iterator &a, const basic_iterator &b) { return a.index_ <= b.index_; }
+        friend bool operator>=(const basic_iterator &a, const basic_iterator &b) { return a.index_ >= b.index_; }
+
+    private:
+        friend class basic_iterator<true>;
+
+        T *const *chunks_ = nullptr; // 块指针表
+        size_t index_ = 0;           // 元素的全局下标
+    };
+
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    chunked_log() = default;
+    chunked_log(const chunked_log &) = delete;
+    chunked_log &operator=(const chunked_log &) = delete;
+
+    ~chunked_log()
+    {
+        clear();
+        for (T *chunk : chunks_)
+        {
+            ::operator delete(static_cast<void *>(chunk), std::align_val_t(alignment));
+        }
+    }
+
+    /**
+     * @brief 在末尾构造一个元素；已有元素不移动，引用保持有效
+     */
+    template <typename... Args>
+    T &emplace_back(Args &&...args)
+    {
+        if (size_ == chunks_.size() * ChunkSize)
+        {
+            add_chunk();
+        }
+        T *slot = chunks_[size_ / ChunkSize] + size_ % ChunkSize;
+        ::new (static_cast<void *>(slot)) T(std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+
+    /**
+     * @brief 销毁所有元素；已分配的块保留，供之后的追加复用
+     */
+    void clear()
+    {
+        for_each_chunk([](const T *first, const T *last) {
+            for (; first != last; ++first)
+            {
+                first->~T();
+            }
+        });
+        size_ = 0;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    T &operator[](size_t i) { return chunks_[i / ChunkSize][i % ChunkSize]; }
+    const T &operator[](size_t i) const { return chunks_[i / ChunkSize][i % ChunkSize]; }
+    T &front() { return (*this)[0]; }
+    const T &front() const { return (*this)[0]; }
+    T &back() { return (*this)[size_ - 1]; }
+    const T &back() const { return (*this)[size_ - 1]; }
+
+    iterator begin() { return iterator(chunks_.data(), 0); }
+    iterator end() { return iterator(chunks_.data(), size_); }
+    const_iterator begin() const { return const_iterator(chunks_.data(), 0); }
+    const_iterator end() const { return const_iterator(chunks_.data(), size_); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    /**
+     * @brief 从第一块到最后一块依次调用f(first, last)，[first, last)是块中已使用的连续区段（const T*）
+     */
+    template <typename F>
+    void for_each_chunk(F &&f) const
+    {
+        size_t full = size_ / ChunkSize;
+        for (size_t c = 0; c < full; ++c)
+        {
+            const T *chunk = chunks_[c];
+            f(chunk, chunk + ChunkSize);
+        }
+        if (size_t rest = size_ % ChunkSize)
+        {
+            const T *chunk = chunks_[full];
+            f(chunk, chunk + rest);
+        }
+    }
+
+    /**
+     * @brief 从最后一块到第一块依次调用f(first, last)
+     */
+    template <typename F>
+    void for_each_chunk_reverse(F &&f) const
+    {
+        size_t full = size_ / ChunkSize;
+        if (size_t rest = size_ % ChunkSize)
+        {
+            const T *chunk = chunks_[full];
+            f(chunk, chunk + rest);
+        }
+        for (size_t c = full; c != 0; --c)
+        {
+            const T *chunk = chunks_[c - 1];
+            f(chunk, chunk + ChunkSize);
+        }
+    }
+
+    /**
+     * @brief 从最后一个元素到第一个元素依次调用f(element)
+     */
+    template <typename F>
+    void for_each_reverse(F &&f) const
+    {
+        for_each_chunk_reverse([&f](const T *first, const T *last) {
+            while (last != first)
+            {
+                f(*--last);
+            }
+        });
+    }
+
+private:
+    void add_chunk()
+    {
+        void *mem = ::operator new(ChunkSize * sizeof(T), std::align_val_t(alignment));
+        try
+        {
+            chunks_.push_back(static_cast<T *>(mem));
+        }
+        catch (...)
+        {
+            ::operator delete(mem, std::align_val_t(alignment));
+            throw;
+        }
+    }
+
+    std::vector<T *> chunks_; // 块指针表：增长时只搬动指针，元素本身不动
+    size_t size_ = 0;
+};
+
+#endif // CHUNKED_LOG_HPP
@@ -0,0 +1,257 @@
+// 基于内存映射（mmap）的文件读取器头文件（仅适用于POSIX系统）
+// 核心特性：把整个文件映射进地址空间，以「迭代器-哨兵」对的形式零拷贝遍历文件内容，
+//           并提供按行/按记录切分的视图，每条记录都是指向映射区的std::string_view
+// 设计思路：与null_sentinel.cpp中的c_string_reader保持相同的begin()/end()接口，
+//           只是哨兵在遇到'\0'或到达映射区末尾时都会终止迭代
+#ifndef MAPPED_FILE_READER_HPP
+#define MAPPED_FILE_READER_HPP
+
+#include <cerrno>       // 提供errno
+#include <cstddef>      // 提供size_t/ptrdiff_t
+#include <cstring>      // 提供memchr
+#include <iterator>     // 提供forward_iterator_tag
+#include <string>       // 提供std::string（文件路径）
+#include <string_view>  // 提供std::string_view（零拷贝的记录）
+#include <system_error> // 提供std::system_error（系统调用失败时抛出）
+#include <utility>      // 提供std::exchange
+
+#include <fcntl.h>    // 提供open
+#include <sys/mman.h> // 提供mmap/munmap/madvise
+#include <sys/stat.h> // 提供fstat
+#include <unistd.h>   // 提供close
+
+/**
+ * @brief 只读内存映射文件（RAII）
+ * 构造时打开并映射文件，析构时解除映射；只可移动，不可拷贝
+ */
+class mapped_file
+{
+public:
+    /**
+     * @brief 映射整个文件，并用madvise提示内核按顺序访问（加大预读）
+     * @param path 文件路径
+     * @throw std::system_error 打开、获取大小或映射失败时抛出
+     */
+    explicit mapped_file(const std::string &path)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            throw std::system_error(errno, std::generic_category(),
+                                    "open " + path);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0)
+        {
+            int err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::generic_category(),
+                                    "fstat " + path);
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        // 长度为0的文件不能映射，此时保持data_为nullptr（空范围）
+        if (size_ != 0)
+        {
+            void *addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED)
+            {
+                int err = errno;
+                ::close(fd);
+                throw std::system_error(err, std::generic_category(),
+                                        "mmap " + path);
+            }
+            data_ = static_cast<const char *>(addr);
+            ::madvise(addr, size_, MADV_SEQUENTIAL);
+        }
+        ::close(fd); // 映射建立后即可关闭文件描述符
+    }
+
+    mapped_file(mapped_file &&rhs) noexcept
+        : data_(std::exchange(rhs.data_, nullptr)),
+          size_(std::exchange(rhs.size_, 0))
+    {
+    }
+
+    mapped_file &operator=(mapped_file &&rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            unmap();
+            data_ = std::exchange(rhs.data_, nullptr);
+            size_ = std::exchange(rhs.size_, 0);
+        }
+        return *this;
+    }
+
+    ~mapped_file() { unmap(); }
+
+    const char *data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    void unmap()
+    {
+        if (data_ != nullptr)
+        {
+            ::munmap(const_cast<char *>(data_), size_);
+        }
+    }
+
+    const char *data_ = nullptr; // 映射区起始地址，空文件时为nullptr
+    size_t size_ = 0;            // 映射区字节数
+};
+
+/**
+ * @brief 映射区哨兵：迭代器指向'\0'或到达映射区末尾时视为结束
+ * 与null_sentinel相比多保存了映射区的尾后指针，避免越过映射区解引用
+ */
+struct mapped_sentinel
+{
+    const char *end; // 映射区的尾后位置
+};
+
+inline bool operator==(const char *i, mapped_sentinel s)
+{
+    return i == s.end || *i == 0;
+}
+
+inline bool operator==(mapped_sentinel s, const char *i)
+{
+    return i == s.end || *i == 0;
+}
+
+inline bool operator!=(const char *i, mapped_sentinel s)
+{
+    return !(i == s);
+}
+
+inline bool operator!=(mapped_sentinel s, const char *i)
+{
+    return !(i == s);
+}
+
+/**
+ * @brief 文件版的C字符串读取器：接口与c_string_reader相同（begin()返回指针，end()返回哨兵）
+ * 可用于范围for循环，以及C++20的std::ranges::for_each(reader.begin(), reader.end(), ...)
+ */
+class mapped_c_string_reader
+{
+public:
+    explicit mapped_c_string_reader(const mapped_file &file)
+        : ptr_(file.data()), end_(file.data() + file.size())
+    {
+    }
+
+    const char *begin() const { return ptr_; }
+    mapped_sentinel end() const { return {end_}; }
+
+private:
+    const char *ptr_; // 映射区起始地址
+    const char *end_; // 映射区尾后地址
+};
+
+/**
+ * @brief 按分隔符切分的记录视图，每条记录为指向映射区的std::string_view
+ * 有效内容为映射区中第一个'\0'之前的部分（没有'\0'时为整个映射区）；
+ * 与getline一致，最后一条记录若以分隔符结尾，不会额外产生一条空记录
+ */
+class record_view
+{
+public:
+    /**
+     * @brief 前向迭代器：解引用得到当前记录，++时用memchr查找下一个分隔符
+     */
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view *;
+        using reference = std::string_view;
+
+        iterator() = default;
+        iterator(const char *pos, const char *last, char delim)
+            : pos_(pos), last_(last), delim_(delim)
+        {
+            find_next();
+        }
+
+        reference operator*() const { return record_; }
+        pointer operator->() const { return &record_; }
+
+        iterator &operator++()
+        {
+            pos_ = next_;
+            find_next();
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        // 两个迭代器都已到达结尾时相等（遇到'\0'提前结束时，pos_不一定等于映射区末尾）
+        bool operator==(const iterator &rhs) const
+        {
+            return pos_ == rhs.pos_ || (pos_ == last_ && rhs.pos_ == rhs.last_);
+        }
+        bool operator!=(const iterator &rhs) const { return !(*this == rhs); }
+
+    private:
+        // 确定从pos_开始的记录，并计算下一条记录的起点next_
+        // 只在当前记录（通常已在缓存中）里查找'\0'，避免预先扫描整个文件
+        void find_next()
+        {
+            if (pos_ == last_)
+            {
+                return;
+            }
+            auto stop = static_cast<const char *>(
+                std::memchr(pos_, delim_, static_cast<size_t>(last_ - pos_)));
+            const char *record_end = stop != nullptr ? stop : last_;
+            next_ = stop != nullptr ? stop + 1 : last_;
+            auto nul = static_cast<const char *>(std::memchr(
+                pos_, '\0', static_cast<size_t>(record_end - pos_)));
+            if (nul != nullptr)
+            {
+                // 遇到终止符：截断当前记录，之后的内容不再属于这个范围
+                record_end = nul;
+                next_ = last_ = nul;
+            }
+            record_ = std::string_view(pos_, static_cast<size_t>(record_end - pos_));
+        }
+
+        const char *pos_ = nullptr;  // 当前记录的起点（等于last_时为尾后迭代器）
+        const char *next_ = nullptr; // 下一条记录的起点
+        const char *last_ = nullptr; // 有效内容的尾后位置（遇到'\0'后缩短）
+        char delim_ = '\n';          // 分隔符
+        std::string_view record_;    // 当前记录
+    };
+
+    record_view(const mapped_file &file, char delim = '\n')
+        : first_(file.data()), last_(file.data() + file.size()), delim_(delim)
+    {
+    }
+
+    iterator begin() const { return iterator(first_, last_, delim_); }
+    iterator end() const { return iterator(last_, last_, delim_); }
+
+private:
+    const char *first_; // 映射区起点
+    const char *last_;  // 映射区尾后位置（遇到'\0'时由迭代器提前结束）
+    char delim_;        // 分隔符
+};
+
+/**
+ * @brief 便捷函数：按行切分映射文件
+ */
+inline record_view lines(const mapped_file &file)
+{
+    return record_view(file, '\n');
+}
+
+#endif // MAPPED_FILE_READER_HPP
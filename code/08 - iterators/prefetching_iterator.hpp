@@ -0,0 +1,142 @@
+// 预取迭代器适配器头文件：遍历list/map这类节点式容器时，提前K个节点发出预取指令
+// 背景：reverse_iterate.cpp的reverseOutput可以接收list、map等节点式容器；节点分散在堆上，
+//       每前进一步都要等待下一个节点从内存中读入，遍历速度受内存延迟限制
+// 核心特性：
+//   1. prefetching_iterator<It>：包装任意前向迭代器It（包括std::reverse_iterator），
+//      内部另有一个领先K步的“探路”迭代器，每前进一步就对探路迭代器所指的元素调用__builtin_prefetch，
+//      等主迭代器走到那里时，节点很可能已经在缓存中
+//   2. 反向遍历时包装rbegin()/rend()即可：prefetch_reversed(c, K)
+//   3. prefetched(c, K)/prefetch_reversed(c, K)返回带begin()/end()的范围，
+//      可用于范围for、标准算法和std::ranges算法；K为0时不预取，等价于原来的迭代器
+// 注意：探路迭代器本身仍要逐个节点地追指针，预取只能让主迭代器上的工作与探路重叠；
+//       每个元素上的工作越多，K的收益越大；K过大时预取的节点可能在用到之前就被挤出缓存
+// 用法：
+//     std::map<int, int> m = ...;
+//     for (const auto &kv : prefetch_reversed(m, 8)) { ... }
+#ifndef PREFETCHING_ITERATOR_HPP
+#define PREFETCHING_ITERATOR_HPP
+
+#include <cstddef>  // 提供size_t/ptrdiff_t
+#include <iterator> // 提供iterator_traits/forward_iterator_tag
+#include <memory>   // 提供std::addressof
+
+/**
+ * @brief 领先K步预取的迭代器适配器
+ * @tparam It 被包装的前向迭代器类型
+ */
+template <typename It>
+class prefetching_iterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename std::iterator_traits<It>::value_type;
+    using difference_type = typename std::iterator_traits<It>::difference_type;
+    using pointer = typename std::iterator_traits<It>::pointer;
+    using reference = typename std::iterator_traits<It>::reference;
+
+    prefetching_iterator() = default;
+
+    /**
+     * @brief 从cur开始遍历到last为止，预取领先distance步的元素
+     */
+    prefetching_iterator(It cur, It last, size_t distance) : cur_(cur), ahead_(cur), last_(last)
+    {
+        // 先把探路迭代器送到领先distance步的位置，沿途的元素都预取一遍
+        for (size_t i = 0; i < distance && ahead_ != last_; ++i)
+        {
+            prefetch();
+            ++ahead_;
+        }
+    }
+
+    reference operator*() const { return *cur_; }
+    pointer operator->() const { return std::addressof(*cur_); }
+
+    prefetching_iterator &operator++()
+    {
+        ++cur_;
+        if (ahead_ != last_)
+        {
+            prefetch();
+            ++ahead_;
+        }
+        return *this;
+    }
+
+    prefetching_iterator operator++(int)
+    {
+        prefetching_iterator tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    // 只比较主迭代器的位置
+    friend bool operator==(const prefetching_iterator &a, const prefetching_iterator &b)
+    {
+        return a.cur_ == b.cur_;
+    }
+
+    friend bool operator!=(const prefetching_iterator &a, const prefetching_iterator &b)
+    {
+        return !(a == b);
+    }
+
+    // 被包装的迭代器
+    It base() const { return cur_; }
+
+private:
+    void prefetch() const
+    {
+        __builtin_prefetch(std::addressof(*ahead_), 0 /* 读 */, 3 /* 尽量留在各级缓存中 */);
+    }
+
+    It cur_{};   // 当前位置
+    It ahead_{}; // 领先的探路位置（不超过last_）
+    It last_{};  // 遍历终点
+};
+
+/**
+ * @brief 由一对prefetching_iterator组成的范围
+ */
+template <typename It>
+class prefetching_range
+{
+public:
+    using iterator = prefetching_iterator<It>;
+
+    prefetching_range(It first, It last, size_t distance)
+        : first_(first, last, distance), last_(last, last, 0)
+    {
+    }
+
+    iterator begin() const { return first_; }
+    iterator end() const { return last_; }
+
+private:
+    iterator first_;
+    iterator last_;
+};
+
+/**
+ * @brief 正向遍历c，预取领先distance步的元素
+ */
+template <typename C>
+auto prefetched(C &c, size_t distance)
+{
+    using std::begin;
+    using std::end;
+    return prefetching_range<decltype(begin(c))>(begin(c), end(c), distance);
+}
+
+/**
+ * @brief 反向遍历c（包装rbegin()/rend()），预取领先distance步的元素
+ */
+template <typename C>
+auto prefetch_reversed(C &c, size_t distance)
+{
+    using std::rbegin;
+    using std::rend;
+    return prefetching_range<decltype(rbegin(c))>(rbegin(c), rend(c), distance);
+}
+
+#endif // PREFETCHING_ITERATOR_HPP
@@ -0,0 +1,243 @@
+// 多分隔符哨兵与记录切分视图头文件
+// 核心特性：
+//   1. delimiter_sentinel<Delims...>：null_sentinel的推广，迭代器指向任一分隔符时终止迭代，
+//      delimiter_sentinel<'\0'>与null_sentinel等价
+//   2. split_records<Delims...>(text)：把文本按任一分隔符切分为std::string_view记录，
+//      查找下一个分隔符时使用SSE2每次比较16字节（单个分隔符时直接使用memchr）
+// 设计思路：记录视图的begin()返回迭代器、end()返回哨兵，
+//           与null_sentinel.cpp中的用法一样可直接交给std::ranges::for_each
+#ifndef SPLIT_RECORDS_HPP
+#define SPLIT_RECORDS_HPP
+
+#include <cstddef>     // 提供size_t/ptrdiff_t
+#include <cstring>     // 提供memchr
+#include <iterator>    // 提供forward_iterator_tag
+#include <string_view> // 提供std::string_view
+
+#ifdef __SSE2__
+#include <emmintrin.h> // 提供SSE2指令
+#endif
+
+/**
+ * @brief 多分隔符哨兵：迭代器指向Delims中的任一字符时视为结束
+ * @tparam Delims 分隔符列表，例如delimiter_sentinel<'\n', '\0', ','>
+ */
+template <char... Delims>
+struct delimiter_sentinel
+{
+    static_assert(sizeof...(Delims) > 0, "at least one delimiter is required");
+
+    /**
+     * @brief 判断字符是否为分隔符（折叠表达式，编译期展开为若干次比较）
+     */
+    static constexpr bool is_delimiter(char ch)
+    {
+        return ((ch == Delims) || ...);
+    }
+};
+
+/**
+ * @brief 迭代器与delimiter_sentinel的比较运算符（与null_sentinel的四个重载对应）
+ */
+template <typename I, char... Delims>
+bool operator==(I i, delimiter_sentinel<Delims...>)
+{
+    return delimiter_sentinel<Delims...>::is_delimiter(*i);
+}
+
+template <typename I, char... Delims>
+bool operator==(delimiter_sentinel<Delims...>, I i)
+{
+    return delimiter_sentinel<Delims...>::is_delimiter(*i);
+}
+
+template <typename I, char... Delims>
+bool operator!=(I i, delimiter_sentinel<Delims...>)
+{
+    return !delimiter_sentinel<Delims...>::is_delimiter(*i);
+}
+
+template <typename I, char... Delims>
+bool operator!=(delimiter_sentinel<Delims...>, I i)
+{
+    return !delimiter_sentinel<Delims...>::is_delimiter(*i);
+}
+
+/**
+ * @brief 16字节分隔符位图：第i位为1表示chunk[i]是分隔符
+ * 每个分隔符比较一次，结果按位或后用movemask压缩为位图
+ */
+#ifdef __SSE2__
+template <char... Delims>
+unsigned delimiter_mask(const char *chunk)
+{
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(chunk));
+    __m128i hits = _mm_setzero_si128();
+    ((hits = _mm_or_si128(hits, _mm_cmpeq_epi8(bytes, _mm_set1_epi8(Delims)))),
+     ...);
+    return static_cast<unsigned>(_mm_movemask_epi8(hits));
+}
+#endif
+
+/**
+ * @brief 在[first, last)中查找第一个分隔符，找不到时返回last
+ * 单个分隔符时使用memchr（标准库通常已高度向量化）；
+ * 多个分隔符时使用SSE2每次检查16字节
+ */
+template <char... Delims>
+const char *find_delimiter(const char *first, const char *last)
+{
+    if constexpr (sizeof...(Delims) == 1)
+    {
+        auto pos = static_cast<const char *>(
+            std::memchr(first, Delims..., static_cast<size_t>(last - first)));
+        return pos != nullptr ? pos : last;
+    }
+    else
+    {
+#ifdef __SSE2__
+        for (; last - first >= 16; first += 16)
+        {
+            if (unsigned mask = delimiter_mask<Delims...>(first))
+            {
+                return first + __builtin_ctz(mask);
+            }
+        }
+#endif
+        // 剩余不足16字节（或不支持SSE2）时逐字节查找
+        while (first != last && !delimiter_sentinel<Delims...>::is_delimiter(*first))
+        {
+            ++first;
+        }
+        return first;
+    }
+}
+
+/**
+ * @brief 记录切分视图：按任一分隔符把文本切分为std::string_view记录
+ * 语义与std::views::split一致：n个分隔符产生n+1条记录（可能为空），空文本不产生记录
+ * @tparam Delims 分隔符列表
+ */
+template <char... Delims>
+class split_records
+{
+public:
+    // 记录视图的哨兵：迭代器越过最后一条记录后与之相等
+    struct sentinel
+    {
+    };
+
+    /**
+     * @brief 前向迭代器：解引用得到当前记录，++时查找下一个分隔符
+     * 多个分隔符时缓存最近一个16字节块的位图：短记录（如CSV字段）往往落在同一块内，
+     * 下一个分隔符可直接从位图中取出，无需重新加载和比较
+     */
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view *;
+        using reference = std::string_view;
+
+        iterator() = default;
+        iterator(const char *first, const char *last)
+            : pos_(first), last_(last), done_(first == last)
+        {
+            if (!done_)
+            {
+                stop_ = next_delimiter(pos_);
+            }
+        }
+
+        reference operator*() const
+        {
+            return std::string_view(pos_, static_cast<size_t>(stop_ - pos_));
+        }
+
+        iterator &operator++()
+        {
+            if (stop_ == last_)
+            {
+                done_ = true; // 最后一条记录之后没有分隔符，迭代结束
+            }
+            else
+            {
+                pos_ = stop_ + 1; // 跳过分隔符
+                stop_ = next_delimiter(pos_);
+            }
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        bool operator==(const iterator &rhs) const
+        {
+            return done_ == rhs.done_ && (done_ || pos_ == rhs.pos_);
+        }
+        bool operator!=(const iterator &rhs) const { return !(*this == rhs); }
+
+        friend bool operator==(const iterator &it, sentinel) { return it.done_; }
+        friend bool operator==(sentinel, const iterator &it) { return it.done_; }
+        friend bool operator!=(const iterator &it, sentinel) { return !it.done_; }
+        friend bool operator!=(sentinel, const iterator &it) { return !it.done_; }
+
+    private:
+        // 从from开始查找下一个分隔符，找不到时返回last_
+        const char *next_delimiter(const char *from)
+        {
+#ifdef __SSE2__
+            if constexpr (sizeof...(Delims) > 1)
+            {
+                for (;;)
+                {
+                    if (chunk_ != nullptr && from - chunk_ < 16)
+                    {
+                        // 屏蔽掉from之前的位，剩下的最低位就是下一个分隔符
+                        unsigned rest = mask_ >> (from - chunk_) << (from - chunk_);
+                        if (rest != 0)
+                        {
+                            return chunk_ + __builtin_ctz(rest);
+                        }
+                        from = chunk_ + 16;
+                    }
+                    if (last_ - from < 16)
+                    {
+                        chunk_ = nullptr;
+                        return find_delimiter<Delims...>(from, last_);
+                    }
+                    chunk_ = from;
+                    mask_ = delimiter_mask<Delims...>(from);
+                }
+            }
+#endif
+            return find_delimiter<Delims...>(from, last_);
+        }
+
+        const char *pos_ = nullptr;   // 当前记录的起点
+        const char *stop_ = nullptr;  // 当前记录的终点（分隔符位置或文本末尾）
+        const char *last_ = nullptr;  // 文本的尾后位置
+        bool done_ = true;            // 是否已越过最后一条记录
+        const char *chunk_ = nullptr; // 位图对应的16字节块起点（无缓存时为nullptr）
+        unsigned mask_ = 0;           // 该块的分隔符位图
+    };
+
+    explicit split_records(std::string_view text) : text_(text) {}
+
+    iterator begin() const
+    {
+        return iterator(text_.data(), text_.data() + text_.size());
+    }
+    sentinel end() const { return {}; }
+
+private:
+    std::string_view text_; // 被切分的文本（视图不拥有数据）
+};
+
+#endif // SPLIT_RECORDS_HPP
@@ -0,0 +1,521 @@
+// 基于C++20协程的异步按行读取头文件（仅适用于POSIX系统）
+// 背景：cxx20_views.cpp的视图管道作用于已经建好的容器；处理大日志时，
+//       先用getline把所有行读进vector<string>再过滤，既要等整个文件读完，又要为每行分配内存
+// 核心特性：
+//   1. generator<T>：最小的协程生成器，是C++20的input_range和view，
+//      可直接接std::views::filter/transform等视图：read_lines(path) | std::views::filter(...)；
+//      它只可移动，保存在变量中的generator需要std::move(g) | ...
+//   2. async_file：以块为单位的异步读取，start()发起读取后立即返回，wait()取得结果；
+//      有<linux/io_uring.h>时优先用io_uring（直接使用系统调用，不依赖liburing）；
+//      头文件不存在、内核不支持或被禁止（io_uring_setup失败）时，改由一个后台线程执行pread
+//   3. read_lines(path, block_size)：两个块缓冲区交替使用——处理当前块的同时，下一块已经在读取中；
+//      每行以std::string_view的形式产出（不含'\n'），指向块缓冲区，不为每行分配内存；
+//      只有跨越两个块的行才复制到一个临时字符串中
+// 注意：产出的string_view只在迭代器前进之前有效（与getline复用同一个string相同），需要保存时请复制
+// 用法：
+//     for (std::string_view line : read_lines("app.log")
+//                                  | std::views::filter([](std::string_view s) { return s.find("ERROR") != s.npos; }))
+//         ...
+#ifndef ASYNC_LINE_READER_HPP
+#define ASYNC_LINE_READER_HPP
+
+#include <atomic>             // 提供std::atomic_ref（io_uring环形队列的头尾下标）
+#include <cerrno>             // 提供errno
+#include <condition_variable> // 提供std::condition_variable（线程版async_file）
+#include <coroutine>          // 提供std::coroutine_handle/suspend_always
+#include <cstddef>            // 提供size_t/ptrdiff_t
+#include <cstring>            // 提供memchr
+#include <exception>          // 提供std::exception_ptr
+#include <iterator>           // 提供std::default_sentinel_t/input_iterator_tag
+#include <memory>             // 提供std::unique_ptr（块缓冲区）
+#include <mutex>              // 提供std::mutex
+#include <ranges>             // 提供std::ranges::view_interface
+#include <string>             // 提供std::string（文件路径、跨块的行）
+#include <string_view>        // 提供std::string_view（产出的行）
+#include <system_error>       // 提供std::system_error
+#include <thread>             // 提供std::thread
+#include <utility>            // 提供std::exchange
+
+#include <fcntl.h>  // 提供open
+#include <unistd.h> // 提供pread/close
+
+#if __has_include(<linux/io_uring.h>) && __has_include(<sys/syscall.h>)
+#define ASYNC_LINE_READER_HAS_IO_URING 1
+#include <linux/io_uring.h> // 提供io_uring_params/io_uring_sqe/io_uring_cqe
+#include <sys/mman.h>       // 提供mmap/munmap
+#include <sys/syscall.h>    // 提供__NR_io_uring_setup/__NR_io_uring_enter
+#else
+#define ASYNC_LINE_READER_HAS_IO_URING 0
+#endif
+
+/**
+ * @brief 协程生成器：每次co_yield产出一个T，按需（惰性）恢复协程
+ * 只可移动；迭代器是单趟的输入迭代器，end()返回std::default_sentinel
+ */
+template <typename T>
+class generator : public std::ranges::view_interface<generator<T>>
+{
+public:
+    struct promise_type
+    {
+        T value{};
+        std::exception_ptr error;
+
+        generator get_return_object()
+        {
+            return generator(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(T v) noexcept
+        {
+            value = std::move(v);
+            return {};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    using handle = std::coroutine_handle<promise_type>;
+
+    class iterator
+    {
+    public:
+        using iterator_concept = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        explicit iterator(handle h) : h_(h) {}
+
+        const T &operator*() const { return h_.promise().value; }
+
+        iterator &operator++()
+        {
+            advance(h_);
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const iterator &it, std::default_sentinel_t) { return it.h_.done(); }
+
+    private:
+        handle h_{};
+    };
+
+    generator() = default;
+    generator(generator &&rhs) noexcept : h_(std::exchange(rhs.h_, {})) {}
+    generator &operator=(generator &&rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            destroy();
+            h_ = std::exchange(rhs.h_, {});
+        }
+        return *this;
+    }
+    ~generator() { destroy(); }
+
+    /**
+     * @brief 运行协程到第一个co_yield（只能调用一次）
+     */
+    iterator begin()
+    {
+        advance(h_);
+        return iterator(h_);
+    }
+    std::default_sentinel_t end() const { return {}; }
+
+private:
+    explicit generator(handle h) : h_(h) {}
+
+    // 恢复协程；协程体内抛出的异常在这里重新抛出给迭代的一方
+    static void advance(handle h)
+    {
+        h.resume();
+        if (h.promise().error)
+        {
+            std::rethrow_exception(std::exchange(h.promise().error, nullptr));
+        }
+    }
+
+    void destroy()
+    {
+        if (h_)
+        {
+            h_.destroy();
+        }
+    }
+
+    handle h_{};
+};
+
+#if ASYNC_LINE_READER_HAS_IO_URING
+namespace async_line_reader_detail
+{
+
+/**
+ * @brief 最小的io_uring封装：只提交读取，同一时刻最多一个请求在进行
+ * 提交队列只由本线程写入，完成队列只由本线程读取；与内核共享的头尾下标用acquire/release访问
+ */
+class uring
+{
+public:
+    uring() = default;
+    uring(const uring &) = delete;
+    uring &operator=(const uring &) = delete;
+    ~uring() { close(); }
+
+    /**
+     * @brief 建立环形队列，失败（内核不支持、被seccomp禁止等）时返回false，调用方改用线程
+     */
+    bool open()
+    {
+        io_uring_params params{};
+        long fd = ::syscall(__NR_io_uring_setup, 2, &params);
+        // IORING_OP_READ与IORING_FEAT_RW_CUR_POS在同一内核版本（5.6）加入，没有该特性时也不支持READ
+        if (fd < 0 || !(params.features & IORING_FEAT_RW_CUR_POS))
+        {
+            if (fd >= 0)
+            {
+                ::close(static_cast<int>(fd));
+            }
+            return false;
+        }
+        fd_ = static_cast<int>(fd);
+        sq_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP; // 两个环共用一次映射
+        if (single_mmap)
+        {
+            sq_size_ = cq_size_ = sq_size_ > cq_size_ ? sq_size_ : cq_size_;
+        }
+        sq_ptr_ = map(sq_size_, IORING_OFF_SQ_RING);
+        cq_ptr_ = single_mmap ? sq_ptr_ : map(cq_size_, IORING_OFF_CQ_RING);
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe *>(map(sqes_size_, IORING_OFF_SQES));
+        if (!sq_ptr_ || !cq_ptr_ || !sqes_)
+        {
+            close();
+            return false;
+        }
+        char *sq = static_cast<char *>(sq_ptr_);
+        char *cq = static_cast<char *>(cq_ptr_);
+        sq_tail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+        cq_head_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+        return true;
+    }
+
+    bool is_open() const { return fd_ >= 0; }
+
+    /**
+     * @brief 提交一个从fd的offset处读取size字节到buf的请求，失败时返回负的错误码
+     */
+    int submit_read(int fd, char *buf, size_t size, off_t offset)
+    {
+        const unsigned tail = *sq_tail_; // 只有本线程写提交队列的尾下标
+        const unsigned index = tail & sq_mask_;
+        io_uring_sqe &sqe = sqes_[index];
+        sqe = io_uring_sqe{};
+        sqe.opcode = IORING_OP_READ;
+        sqe.fd = fd;
+        sqe.addr = reinterpret_cast<__u64>(buf);
+        sqe.len = static_cast<__u32>(size);
+        sqe.off = static_cast<__u64>(offset);
+        sq_array_[index] = index;
+        std::atomic_ref<unsigned>(*sq_tail_).store(tail + 1, std::memory_order_release); // 内核看到尾下标时sqe已写好
+        return enter(1, 0, 0);
+    }
+
+    /**
+     * @brief 等待一个完成事件，返回其结果（读到的字节数，或负的错误码）
+     */
+    int wait_completion()
+    {
+        const unsigned head = *cq_head_; // 只有本线程写完成队列的头下标
+        while (std::atomic_ref<unsigned>(*cq_tail_).load(std::memory_order_acquire) == head)
+        {
+            if (int r = enter(0, 1, IORING_ENTER_GETEVENTS); r < 0)
+            {
+                return r;
+            }
+        }
+        const int res = cqes_[head & cq_mask_].res;
+        std::atomic_ref<unsigned>(*cq_head_).store(head + 1, std::memory_order_release); // 归还这个完成事件
+        return res;
+    }
+
+private:
+    void *map(size_t size, off_t offset)
+    {
+        void *p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, offset);
+        return p == MAP_FAILED ? nullptr : p;
+    }
+
+    int enter(unsigned to_submit, unsigned min_complete, unsigned flags)
+    {
+        long r;
+        do
+        {
+            r = ::syscall(__NR_io_uring_enter, fd_, to_submit, min_complete, flags, nullptr, 0);
+        } while (r < 0 && errno == EINTR);
+        return r < 0 ? -errno : static_cast<int>(r);
+    }
+
+    void close()
+    {
+        if (sqes_)
+        {
+            ::munmap(sqes_, sqes_size_);
+        }
+        if (cq_ptr_ && cq_ptr_ != sq_ptr_)
+        {
+            ::munmap(cq_ptr_, cq_size_);
+        }
+        if (sq_ptr_)
+        {
+            ::munmap(sq_ptr_, sq_size_);
+        }
+        if (fd_ >= 0)
+        {
+            ::close(fd_);
+        }
+        sqes_ = nullptr;
+        sq_ptr_ = cq_ptr_ = nullptr;
+        fd_ = -1;
+    }
+
+    int fd_ = -1;
+    void *sq_ptr_ = nullptr;
+    void *cq_ptr_ = nullptr;
+    size_t sq_size_ = 0;
+    size_t cq_size_ = 0;
+    io_uring_sqe *sqes_ = nullptr;
+    size_t sqes_size_ = 0;
+    unsigned *sq_tail_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned *sq_array_ = nullptr;
+    unsigned *cq_head_ = nullptr;
+    unsigned *cq_tail_ = nullptr;
+    unsigned cq_mask_ = 0;
+    io_uring_cqe *cqes_ = nullptr;
+};
+
+} // namespace async_line_reader_detail
+#endif
+
+/**
+ * @brief 以块为单位异步读取的文件：同一时刻最多有一个读取在进行
+ * start(buf, size, offset)发起读取，wait()等待其完成并返回读到的字节数（0表示文件结束）
+ * use_io_uring为false，或io_uring不可用时，由后台线程执行pread；backend()返回实际使用的方式
+ */
+class async_file
+{
+public:
+    explicit async_file(const std::string &path, bool use_io_uring = true)
+    {
+        fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd_ < 0)
+        {
+            throw std::system_error(errno, std::generic_category(), "open " + path);
+        }
+#if ASYNC_LINE_READER_HAS_IO_URING
+        if (use_io_uring && ring_.open())
+        {
+            return;
+        }
+#else
+        (void)use_io_uring;
+#endif
+        worker_ = std::thread([this] { worker_loop(); });
+    }
+
+    async_file(const async_file &) = delete;
+    async_file &operator=(const async_file &) = delete;
+
+    ~async_file()
+    {
+        if (pending_)
+        {
+            try
+            {
+                wait(); // 不能在读取进行中释放缓冲区或关闭文件
+            }
+            catch (...)
+            {
+            }
+        }
+        if (worker_.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopping_ = true;
+            }
+            cv_.notify_all();
+            worker_.join();
+        }
+        ::close(fd_);
+    }
+
+    const char *backend() const { return worker_.joinable() ? "thread" : "io_uring"; }
+
+    void start(char *buf, size_t size, off_t offset)
+    {
+#if ASYNC_LINE_READER_HAS_IO_URING
+        if (ring_.is_open())
+        {
+            if (int r = ring_.submit_read(fd_, buf, size, offset); r < 0)
+            {
+                throw std::system_error(-r, std::generic_category(), "io_uring_enter");
+            }
+            pending_ = true;
+            return;
+        }
+#endif
+        pending_ = true;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            request_ = request{buf, size, offset};
+            has_request_ = true;
+        }
+        cv_.notify_all();
+    }
+
+    size_t wait()
+    {
+        pending_ = false;
+#if ASYNC_LINE_READER_HAS_IO_URING
+        if (ring_.is_open())
+        {
+            int res = ring_.wait_completion();
+            if (res < 0)
+            {
+                throw std::system_error(-res, std::generic_category(), "read");
+            }
+            return static_cast<size_t>(res);
+        }
+#endif
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return has_result_; });
+        has_result_ = false;
+        if (result_ < 0)
+        {
+            throw std::system_error(error_, std::generic_category(), "pread");
+        }
+        return static_cast<size_t>(result_);
+    }
+
+private:
+    int fd_ = -1;
+    bool pending_ = false; // 是否有尚未wait的读取
+#if ASYNC_LINE_READER_HAS_IO_URING
+    async_line_reader_detail::uring ring_;
+#endif
+
+    struct request
+    {
+        char *buf;
+        size_t size;
+        off_t offset;
+    };
+
+    // 后台线程：等待请求，执行pread，交回结果
+    void worker_loop()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;)
+        {
+            cv_.wait(lock, [this] { return has_request_ || stopping_; });
+            if (!has_request_)
+            {
+                return;
+            }
+            request req = request_;
+            has_request_ = false;
+            lock.unlock();
+            ssize_t n;
+            do
+            {
+                n = ::pread(fd_, req.buf, req.size, req.offset);
+            } while (n < 0 && errno == EINTR);
+            int err = errno;
+            lock.lock();
+            result_ = n;
+            error_ = err;
+            has_result_ = true;
+            cv_.notify_all();
+        }
+    }
+
+    std::thread worker_; // 只在线程方式下启动
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    request request_{};
+    bool has_request_ = false;
+    bool has_result_ = false;
+    bool stopping_ = false;
+    ssize_t result_ = 0;
+    int error_ = 0;
+};
+
+/**
+ * @brief 逐行读取文件：产出不含'\n'的行；最后一行没有'\n'时也会产出
+ * @param path 文件路径
+ * @param block_size 每次读取的字节数
+ * @param use_io_uring 是否优先使用io_uring（false时总是使用后台线程）
+ */
+inline generator<std::string_view> read_lines(std::string path, size_t block_size = 1 << 20,
+                                              bool use_io_uring = true)
+{
+    // 缓冲区必须在file之前定义：提前结束迭代（break、views::take）时协程帧按相反顺序销毁局部变量，
+    // ~async_file先等待进行中的读取完成，之后才能释放它正在写入的缓冲区
+    std::unique_ptr<char[]> buffers[2] = {std::make_unique<char[]>(block_size),
+                                          std::make_unique<char[]>(block_size)};
+    async_file file(path, use_io_uring);
+    std::string carry; // 跨越块边界的行的前半部分
+    off_t offset = 0;
+    int cur = 0;
+
+    file.start(buffers[cur].get(), block_size, offset);
+    for (;;)
+    {
+        size_t n = file.wait();
+        if (n == 0)
+        {
+            break;
+        }
+        offset += static_cast<off_t>(n);
+        // 先发起下一块的读取，再处理当前块：读取与处理重叠
+        file.start(buffers[1 - cur].get(), block_size, offset);
+
+        const char *p = buffers[cur].get();
+        const char *end = p + n;
+        while (const char *nl = static_cast<const char *>(memchr(p, '\n', static_cast<size_t>(end - p))))
+        {
+            if (carry.empty())
+            {
+                co_yield std::string_view(p, static_cast<size_t>(nl - p));
+            }
+            else
+            {
+                carry.append(p, nl);
+                co_yield std::string_view(carry);
+                carry.clear();
+            }
+            p = nl + 1;
+        }
+        carry.append(p, end);
+        cur = 1 - cur;
+    }
+    if (!carry.empty())
+    {
+        co_yield std::string_view(carry);
+    }
+}
+
+#endif // ASYNC_LINE_READER_HPP
@@ -0,0 +1,413 @@
+// 有序向量映射（flat_map）头文件：cxx20_views.cpp等视图示例中std::map的替代品
+// 背景：std::map的每个元素是一个红黑树节点，散落在堆上；reverse/filter/values这样的遍历
+//       每走一步都要沿指针跳到另一个节点，缓存命中率低。视图示例中的map构建后只读，
+//       用按键排序的连续数组存放更合适
+// 核心特性：
+//   1. 键和值分别存放在两个连续数组中：只看键的遍历（filter按键筛选、二分查找）不会把值读进缓存
+//   2. 迭代器是随机访问迭代器，解引用得到派生自std::pair<const K &, V &>的代理引用（指向两个数组中的元素），
+//      因此pr.first/pr.second的写法与std::map相同，也能直接用于std::views::keys/values/reverse
+//      （reverse的begin()是O(1)的，不必像双向迭代器那样先走到末尾）
+//   3. keys()/values()直接返回两个数组的std::span，是连续范围，遍历最快
+//   4. 批量构造/插入：先把所有元素追加到末尾，再一次排序、去重，整体O(n log n)；
+//      而逐个insert每次都要移动插入点之后的元素（O(n)），只适合少量插入
+//   5. 键重复时与std::map::insert相同：保留先出现（已存在）的元素
+// 用法：
+//     flat_map<int, std::string> mp{{1, "one"}, {2, "two"}, {3, "three"}, {4, "four"}};
+//     mp | std::views::reverse | std::views::filter([](const auto &pr) { return pr.first % 2 == 0; })
+//        | std::views::values;                   // "four" "two"
+//     mp.insert(more.begin(), more.end());       // 批量插入后整体排序
+#ifndef FLAT_MAP_HPP
+#define FLAT_MAP_HPP
+
+#include <algorithm>        // 提供std::lower_bound/upper_bound/stable_sort
+#include <cstddef>          // 提供size_t/ptrdiff_t
+#include <functional>       // 提供std::less
+#include <initializer_list> // 提供std::initializer_list
+#include <iterator>         // 提供std::random_access_iterator_tag/reverse_iterator
+#include <numeric>          // 提供std::iota
+#include <span>             // 提供std::span（keys()/values()）
+#include <stdexcept>        // 提供std::out_of_range
+#include <tuple>            // 提供std::tuple_size/tuple_element（代理引用的结构化绑定）
+#include <type_traits>      // 提供std::conditional_t/is_nothrow_move_constructible_v
+#include <utility>          // 提供std::pair/move
+#include <vector>
+
+namespace flat_map_detail
+{
+
+/**
+ * @brief 迭代器的代理引用：first/second分别引用键数组和值数组中的元素，M为V或const V
+ * 不直接使用std::pair<const K &, M &>：C++20中它与std::pair<K, V> &之间没有common_reference
+ * （两个方向都能转换，有歧义），迭代器就不满足std::indirectly_readable，不能用于视图
+ */
+template <typename K, typename M>
+struct pair_ref : std::pair<const K &, M &>
+{
+    pair_ref(const K &k, M &v) : std::pair<const K &, M &>(k, v) {}
+};
+
+} // namespace flat_map_detail
+
+// 代理引用的结构化绑定与std::views::keys/values需要tuple_size/tuple_element；
+// common_reference规定代理引用与value_type（std::pair<K, V>）的公共类型是std::pair<K, V>
+template <typename K, typename M>
+struct std::tuple_size<flat_map_detail::pair_ref<K, M>> : std::integral_constant<size_t, 2>
+{
+};
+
+template <size_t I, typename K, typename M>
+struct std::tuple_element<I, flat_map_detail::pair_ref<K, M>> : std::tuple_element<I, std::pair<const K &, M &>>
+{
+};
+
+template <typename K, typename M, typename V, template <typename> class TQual, template <typename> class UQual>
+struct std::basic_common_reference<flat_map_detail::pair_ref<K, M>, std::pair<K, V>, TQual, UQual>
+{
+    using type = std::pair<K, V>;
+};
+
+template <typename K, typename M, typename V, template <typename> class TQual, template <typename> class UQual>
+struct std::basic_common_reference<std::pair<K, V>, flat_map_detail::pair_ref<K, M>, TQual, UQual>
+{
+    using type = std::pair<K, V>;
+};
+
+/**
+ * @brief 构造函数的标签：传入的键已经严格递增（有序且无重复），不再排序
+ */
+struct sorted_unique_t
+{
+    explicit sorted_unique_t() = default;
+};
+inline constexpr sorted_unique_t sorted_unique{};
+
+template <typename K, typename V, typename Compare = std::less<K>>
+class flat_map
+{
+    template <bool Const>
+    class basic_iterator;
+
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<K, V>;
+    using key_compare = Compare;
+    using reference = flat_map_detail::pair_ref<K, V>;
+    using const_reference = flat_map_detail::pair_ref<K, const V>;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    flat_map() = default;
+
+    explicit flat_map(const Compare &comp) : comp_(comp) {}
+
+    template <typename It>
+    flat_map(It first, It last, const Compare &comp = Compare()) : comp_(comp)
+    {
+        insert(first, last);
+    }
+
+    flat_map(std::initializer_list<value_type> init, const Compare &comp = Compare())
+        : flat_map(init.begin(), init.end(), comp)
+    {
+    }
+
+    /**
+     * @brief 直接接管已排序、无重复的键数组和对应的值数组（两者长度必须相同）
+     */
+    flat_map(sorted_unique_t, std::vector<K> keys, std::vector<V> values, const Compare &comp = Compare())
+        : keys_(std::move(keys)), values_(std::move(values)), comp_(comp)
+    {
+    }
+
+    // ===== 容量 =====
+    bool empty() const { return keys_.empty(); }
+    size_type size() const { return keys_.size(); }
+
+    void reserve(size_type n)
+    {
+        keys_.reserve(n);
+        values_.reserve(n);
+    }
+
+    void clear()
+    {
+        keys_.clear();
+        values_.clear();
+    }
+
+    // ===== 迭代器 =====
+    iterator begin() { return iterator(keys_.data(), values_.data()); }
+    iterator end() { return begin() + static_cast<difference_type>(size()); }
+    const_iterator begin() const { return const_iterator(keys_.data(), values_.data()); }
+    const_iterator end() const { return begin() + static_cast<difference_type>(size()); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    /**
+     * @brief 按键的顺序排列的键数组（只读：修改键会破坏有序性）
+     */
+    std::span<const K> keys() const { return keys_; }
+
+    /**
+     * @brief 与keys()一一对应的值数组
+     */
+    std::span<V> values() { return values_; }
+    std::span<const V> values() const { return values_; }
+
+    // ===== 查找 =====
+    iterator lower_bound(const K &key) { return begin() + key_lower_bound(key); }
+    const_iterator lower_bound(const K &key) const { return begin() + key_lower_bound(key); }
+
+    iterator upper_bound(const K &key)
+    {
+        return begin() + (std::upper_bound(keys_.begin(), keys_.end(), key, comp_) - keys_.begin());
+    }
+    const_iterator upper_bound(const K &key) const
+    {
+        return begin() + (std::upper_bound(keys_.begin(), keys_.end(), key, comp_) - keys_.begin());
+    }
+
+    iterator find(const K &key)
+    {
+        difference_type i = key_lower_bound(key);
+        return matches(i, key) ? begin() + i : end();
+    }
+    const_iterator find(const K &key) const
+    {
+        difference_type i = key_lower_bound(key);
+        return matches(i, key) ? begin() + i : end();
+    }
+
+    bool contains(const K &key) const { return matches(key_lower_bound(key), key); }
+    size_type count(const K &key) const { return contains(key) ? 1 : 0; }
+
+    V &at(const K &key)
+    {
+        difference_type i = key_lower_bound(key);
+        if (!matches(i, key))
+        {
+            throw std::out_of_range("flat_map::at");
+        }
+        return values_[static_cast<size_t>(i)];
+    }
+    const V &at(const K &key) const { return const_cast<flat_map *>(this)->at(key); }
+
+    V &operator[](const K &key) { return try_emplace(key).first->second; }
+
+    // ===== 修改 =====
+    /**
+     * @brief 键不存在时插入(key, V(args...))，返回元素的迭代器以及是否插入
+     * 插入点之后的元素都要后移一位：逐个插入大量元素时请改用批量insert
+     */
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const K &key, Args &&...args)
+    {
+        difference_type i = key_lower_bound(key);
+        if (matches(i, key))
+        {
+            return {begin() + i, false};
+        }
+        // 先插入值（构造V可能抛出异常），键插入失败时再撤销，两个数组始终一样长
+        values_.emplace(values_.begin() + i, std::forward<Args>(args)...);
+        try
+        {
+            keys_.insert(keys_.begin() + i, key);
+        }
+        catch (...)
+        {
+            values_.erase(values_.begin() + i);
+            throw;
+        }
+        return {begin() + i, true};
+    }
+
+    std::pair<iterator, bool> insert(const value_type &kv) { return try_emplace(kv.first, kv.second); }
+
+    /**
+     * @brief 批量插入：全部追加到末尾后统一排序、去重（与已有元素重复的键不会覆盖已有的值）
+     */
+    template <typename It>
+    void insert(It first, It last)
+    {
+        const size_t old_size = keys_.size();
+        try
+        {
+            for (; first != last; ++first)
+            {
+                keys_.push_back(first->first);
+                values_.push_back(first->second);
+            }
+            sort_and_unique();
+        }
+        catch (...)
+        {
+            // 去掉追加了一半的元素，两个数组恢复到原来的长度
+            keys_.erase(keys_.begin() + static_cast<difference_type>(old_size), keys_.end());
+            values_.erase(values_.begin() + static_cast<difference_type>(old_size), values_.end());
+            throw;
+        }
+    }
+
+    size_type erase(const K &key)
+    {
+        difference_type i = key_lower_bound(key);
+        if (!matches(i, key))
+        {
+            return 0;
+        }
+        erase(begin() + i);
+        return 1;
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        difference_type i = pos - cbegin();
+        keys_.erase(keys_.begin() + i);
+        values_.erase(values_.begin() + i);
+        return begin() + i;
+    }
+
+    key_compare key_comp() const { return comp_; }
+
+private:
+    /**
+     * @brief 随机访问迭代器：同时指向键数组和值数组中的同一位置
+     */
+    template <bool Const>
+    class basic_iterator
+    {
+        using mapped = std::conditional_t<Const, const V, V>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::pair<K, V>;
+        using difference_type = std::ptrdiff_t;
+        using reference = flat_map_detail::pair_ref<K, mapped>;
+
+        // 代理引用是临时对象，operator->把它保存在返回值中
+        struct pointer
+        {
+            reference ref;
+            const reference *operator->() const { return &ref; }
+        };
+
+        basic_iterator() = default;
+        basic_iterator(const K *k, mapped *v) : k_(k), v_(v) {}
+
+        // iterator可以转换为const_iterator
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        basic_iterator(const basic_iterator<false> &it) : k_(it.k_), v_(it.v_)
+        {
+        }
+
+        reference operator*() const { return {*k_, *v_}; }
+        pointer operator->() const { return pointer{**this}; }
+        reference operator[](difference_type n) const { return {k_[n], v_[n]}; }
+
+        basic_iterator &operator++()
+        {
+            ++k_;
+            ++v_;
+            return *this;
+        }
+        basic_iterator operator++(int)
+        {
+            basic_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        basic_iterator &operator--()
+        {
+            --k_;
+            --v_;
+            return *this;
+        }
+        basic_iterator operator--(int)
+        {
+            basic_iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+        basic_iterator &operator+=(difference_type n)
+        {
+            k_ += n;
+            v_ += n;
+            return *this;
+        }
+        basic_iterator &operator-=(difference_type n) { return *this += -n; }
+
+        friend basic_iterator operator+(basic_iterator it, difference_type n) { return it += n; }
+        friend basic_iterator operator+(difference_type n, basic_iterator it) { return it += n; }
+        friend basic_iterator operator-(basic_iterator it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const basic_iterator &a, const basic_iterator &b) { return a.k_ - b.k_; }
+
+        friend bool operator==(const basic_iterator &a, const basic_iterator &b) { return a.k_ == b.k_; }
+        friend auto operator<=>(const basic_iterator &a, const basic_iterator &b) { return a.k_ <=> b.k_; }
+
+    private:
+        friend class basic_iterator<true>;
+
+        const K *k_ = nullptr;
+        mapped *v_ = nullptr;
+    };
+
+    difference_type key_lower_bound(const K &key) const
+    {
+        return std::lower_bound(keys_.begin(), keys_.end(), key, comp_) - keys_.begin();
+    }
+
+    bool matches(difference_type i, const K &key) const
+    {
+        return i != static_cast<difference_type>(keys_.size()) && !comp_(key, keys_[static_cast<size_t>(i)]);
+    }
+
+    // 按键稳定排序下标（相等的键保留先出现的），再按下标顺序把两个数组搬到新数组中
+    // 新数组全部建好之后才替换keys_/values_：只有K和V的移动构造都不抛出异常时才移动元素，
+    // 否则复制，这样中途抛出异常时原数组保持原样，insert的回滚只需截掉追加的部分
+    void sort_and_unique()
+    {
+        std::vector<size_t> order(keys_.size());
+        std::iota(order.begin(), order.end(), size_t(0));
+        std::stable_sort(order.begin(), order.end(),
+                         [this](size_t a, size_t b) { return comp_(keys_[a], keys_[b]); });
+
+        std::vector<K> keys;
+        std::vector<V> values;
+        keys.reserve(order.size());
+        values.reserve(order.size());
+        for (size_t i : order)
+        {
+            if (!keys.empty() && !comp_(keys.back(), keys_[i]))
+            {
+                continue; // 与前一个键相等
+            }
+            if constexpr (std::is_nothrow_move_constructible_v<K> && std::is_nothrow_move_constructible_v<V>)
+            {
+                keys.push_back(std::move(keys_[i]));
+                values.push_back(std::move(values_[i]));
+            }
+            else
+            {
+                keys.push_back(keys_[i]);
+                values.push_back(values_[i]);
+            }
+        }
+        keys_.swap(keys);
+        values_.swap(values);
+    }
+
+    std::vector<K> keys_;
+    std::vector<V> values_;
+    [[no_unique_address]] Compare comp_;
+};
+
+#endif // FLAT_MAP_HPP
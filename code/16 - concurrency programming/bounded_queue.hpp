@@ -0,0 +1,301 @@
+// 有界无锁队列头文件：在流水线的各个线程之间传递数据（解析 -> 过滤 -> 格式化输出）
+// 背景：用互斥量保护的队列，每个元素都要加锁、解锁，生产者与消费者还会争抢同一把锁；
+//       流水线中每个元素的处理很轻时，锁的开销和等待会成为瓶颈
+// 核心特性：
+//   1. spsc_queue<T>：单生产者单消费者环形缓冲区，只用两个原子下标（各占一个缓存行，避免伪共享），
+//      每一方还缓存对方的下标，只有看起来满/空时才重新读取对方的原子变量
+//   2. mpmc_queue<T>：多生产者多消费者，Dmitry Vyukov的有界队列：每个槽位带一个序号，
+//      生产者/消费者用CAS争抢位置，抢到后只操作自己的槽位
+//   3. 两者的接口相同：
+//      - try_push(x)/try_pop(x)：队列满/空时立即返回false；try_push失败时不会移走x
+//      - push_n(first, n)/pop_n(out, n)：批量操作，一次最多处理n个，返回实际处理的个数；
+//        一次原子操作（mpmc为一次CAS）认领多个槽位，摊薄每个元素的同步开销
+//   4. 容量向上取整到2的幂（至少为2），用位与代替取模
+// 注意：队列满/空时不会阻塞等待，调用方自己决定是自旋、让出CPU还是做别的事
+// 用法：
+//     mpmc_queue<record> q(1024);
+//     // 生产者：while (!q.try_push(std::move(r))) std::this_thread::yield(); // 失败时r保持不变
+//     // 消费者：record buf[64]; size_t n = q.pop_n(buf, 64);
+#ifndef BOUNDED_QUEUE_HPP
+#define BOUNDED_QUEUE_HPP
+
+#include <atomic>      // 提供std::atomic
+#include <cstddef>     // 提供size_t/ptrdiff_t
+#include <memory>      // 提供std::unique_ptr
+#include <new>         // 提供placement new
+#include <type_traits> // 提供std::is_nothrow_move_constructible_v
+#include <utility>     // 提供std::move
+
+namespace bounded_queue_detail
+{
+
+// 缓存行大小：两个频繁被不同线程写的变量至少相隔这么远，才不会互相使对方的缓存行失效
+// （没有使用std::hardware_destructive_interference_size，GCC会对它在头文件中的使用给出警告）
+constexpr size_t cache_line = 64;
+
+inline size_t round_up_pow2(size_t n)
+{
+    size_t c = 2;
+    while (c < n)
+    {
+        c <<= 1;
+    }
+    return c;
+}
+
+// 未初始化的T存储，由队列在push时构造、pop时析构
+template <typename T>
+struct slot_storage
+{
+    alignas(T) unsigned char bytes[sizeof(T)];
+
+    T *get() { return reinterpret_cast<T *>(bytes); }
+};
+
+} // namespace bounded_queue_detail
+
+/**
+ * @brief 单生产者单消费者有界队列：同一时刻只能有一个线程push、一个线程pop
+ */
+template <typename T>
+class spsc_queue
+{
+    static_assert(std::is_nothrow_move_constructible_v<T>, "T的移动构造不能抛出异常");
+
+public:
+    explicit spsc_queue(size_t capacity)
+        : mask_(bounded_queue_detail::round_up_pow2(capacity) - 1),
+          slots_(std::make_unique<bounded_queue_detail::slot_storage<T>[]>(mask_ + 1))
+    {
+    }
+
+    spsc_queue(const spsc_queue &) = delete;
+    spsc_queue &operator=(const spsc_queue &) = delete;
+
+    ~spsc_queue()
+    {
+        for (size_t i = head_.load(std::memory_order_relaxed), e = tail_.load(std::memory_order_relaxed); i != e; ++i)
+        {
+            slots_[i & mask_].get()->~T();
+        }
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+    // 只有认领到槽位后才复制/移动value：失败时调用方的对象保持不变，可以原样重试
+    bool try_push(const T &value) { return push_n(&value, 1) == 1; }
+    bool try_push(T &&value) { return push_n(&value, 1) == 1; }
+
+    bool try_pop(T &out) { return pop_n(&out, 1) == 1; }
+
+    /**
+     * @brief 从first开始移动至多n个元素入队，返回入队的个数（只能由生产者线程调用）
+     */
+    template <typename It>
+    size_t push_n(It first, size_t n)
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t free = capacity() - (tail - cached_head_);
+        if (free < n)
+        {
+            cached_head_ = head_.load(std::memory_order_acquire); // 看起来空间不够时才读取消费者的下标
+            free = capacity() - (tail - cached_head_);
+        }
+        const size_t k = n < free ? n : free;
+        for (size_t i = 0; i < k; ++i, ++first)
+        {
+            ::new (slots_[(tail + i) & mask_].get()) T(std::move(*first));
+        }
+        if (k != 0)
+        {
+            tail_.store(tail + k, std::memory_order_release); // 一次发布k个元素
+        }
+        return k;
+    }
+
+    /**
+     * @brief 至多出队n个元素，依次移动赋值给*out++，返回出队的个数（只能由消费者线程调用）
+     */
+    template <typename Out>
+    size_t pop_n(Out out, size_t n)
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        size_t ready = cached_tail_ - head;
+        if (ready < n)
+        {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            ready = cached_tail_ - head;
+        }
+        const size_t k = n < ready ? n : ready;
+        for (size_t i = 0; i < k; ++i, ++out)
+        {
+            T *p = slots_[(head + i) & mask_].get();
+            *out = std::move(*p);
+            p->~T();
+        }
+        if (k != 0)
+        {
+            head_.store(head + k, std::memory_order_release);
+        }
+        return k;
+    }
+
+private:
+    const size_t mask_;
+    std::unique_ptr<bounded_queue_detail::slot_storage<T>[]> slots_;
+
+    // 消费者写head_、生产者写tail_；各自的缓存副本与自己的下标放在同一缓存行
+    alignas(bounded_queue_detail::cache_line) std::atomic<size_t> head_{0};
+    size_t cached_tail_ = 0; // 消费者上次看到的tail_
+    alignas(bounded_queue_detail::cache_line) std::atomic<size_t> tail_{0};
+    size_t cached_head_ = 0; // 生产者上次看到的head_
+    alignas(bounded_queue_detail::cache_line) char padding_[1]{}; // 避免其后的对象与tail_共享缓存行
+};
+
+/**
+ * @brief 多生产者多消费者有界队列（Vyukov）
+ * 槽位i的序号seq：等于位置pos表示可写入，等于pos + 1表示已写入、可读取；
+ * 读取后设为pos + 容量，即下一圈的同一槽位可写入
+ */
+template <typename T>
+class mpmc_queue
+{
+    static_assert(std::is_nothrow_move_constructible_v<T>, "T的移动构造不能抛出异常");
+
+public:
+    explicit mpmc_queue(size_t capacity)
+        : mask_(bounded_queue_detail::round_up_pow2(capacity) - 1),
+          cells_(std::make_unique<cell[]>(mask_ + 1))
+    {
+        for (size_t i = 0; i <= mask_; ++i)
+        {
+            cells_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    mpmc_queue(const mpmc_queue &) = delete;
+    mpmc_queue &operator=(const mpmc_queue &) = delete;
+
+    ~mpmc_queue()
+    {
+        for (size_t i = dequeue_pos_.load(std::memory_order_relaxed), e = enqueue_pos_.load(std::memory_order_relaxed);
+             i != e; ++i)
+        {
+            cells_[i & mask_].value.get()->~T();
+        }
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+    // 只有认领到槽位后才复制/移动value：失败时调用方的对象保持不变，可以原样重试
+    bool try_push(const T &value) { return push_n(&value, 1) == 1; }
+    bool try_push(T &&value) { return push_n(&value, 1) == 1; }
+
+    bool try_pop(T &out) { return pop_n(&out, 1) == 1; }
+
+    /**
+     * @brief 从first开始移动至多n个元素入队，返回入队的个数（可由多个线程同时调用）
+     */
+    template <typename It>
+    size_t push_n(It first, size_t n)
+    {
+        if (n == 0)
+        {
+            return 0;
+        }
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        size_t k;
+        for (;;)
+        {
+            // 从pos开始连续可写入的槽位数：一旦可写入，在enqueue_pos_越过它之前不会改变，
+            // 所以CAS成功后这k个槽位都归当前线程
+            k = 0;
+            while (k < n && cells_[(pos + k) & mask_].seq.load(std::memory_order_acquire) == pos + k)
+            {
+                ++k;
+            }
+            if (k == 0)
+            {
+                size_t seq = cells_[pos & mask_].seq.load(std::memory_order_acquire);
+                if (static_cast<std::ptrdiff_t>(seq - pos) < 0)
+                {
+                    return 0; // 槽位还留着上一圈未读取的元素：队列已满
+                }
+                pos = enqueue_pos_.load(std::memory_order_relaxed); // 其他生产者已经占用了pos
+                continue;
+            }
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        for (size_t i = 0; i < k; ++i, ++first)
+        {
+            cell &c = cells_[(pos + i) & mask_];
+            ::new (c.value.get()) T(std::move(*first));
+            c.seq.store(pos + i + 1, std::memory_order_release);
+        }
+        return k;
+    }
+
+    /**
+     * @brief 至多出队n个元素，依次移动赋值给*out++，返回出队的个数（可由多个线程同时调用）
+     */
+    template <typename Out>
+    size_t pop_n(Out out, size_t n)
+    {
+        if (n == 0)
+        {
+            return 0;
+        }
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        size_t k;
+        for (;;)
+        {
+            k = 0;
+            while (k < n && cells_[(pos + k) & mask_].seq.load(std::memory_order_acquire) == pos + k + 1)
+            {
+                ++k;
+            }
+            if (k == 0)
+            {
+                size_t seq = cells_[pos & mask_].seq.load(std::memory_order_acquire);
+                if (static_cast<std::ptrdiff_t>(seq - (pos + 1)) < 0)
+                {
+                    return 0; // 槽位尚未写入：队列为空
+                }
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (dequeue_pos_.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        for (size_t i = 0; i < k; ++i, ++out)
+        {
+            cell &c = cells_[(pos + i) & mask_];
+            T *p = c.value.get();
+            *out = std::move(*p);
+            p->~T();
+            c.seq.store(pos + i + mask_ + 1, std::memory_order_release);
+        }
+        return k;
+    }
+
+private:
+    struct cell
+    {
+        std::atomic<size_t> seq;
+        bounded_queue_detail::slot_storage<T> value;
+    };
+
+    const size_t mask_;
+    std::unique_ptr<cell[]> cells_;
+
+    alignas(bounded_queue_detail::cache_line) std::atomic<size_t> enqueue_pos_{0};
+    alignas(bounded_queue_detail::cache_line) std::atomic<size_t> dequeue_pos_{0};
+    alignas(bounded_queue_detail::cache_line) char padding_[1]{};
+};
+
+#endif // BOUNDED_QUEUE_HPP
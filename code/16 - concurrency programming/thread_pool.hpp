@@ -0,0 +1,323 @@
+// 工作窃取（work-stealing）线程池头文件
+// 核心特性：
+//   1. 每个工作线程有自己的双端队列：自己从尾部压入/取出（后进先出，刚拆分出的任务数据还在缓存中），
+//      空闲时从其他线程队列的头部“窃取”（先进先出，偷走的往往是较大的一块工作）
+//   2. 外部线程提交的任务放入共享的注入队列；工作线程内部提交的任务直接放入自己的队列
+//   3. submit(f, args...)返回std::future，任务中的异常通过future传回
+//   4. parallel_for(first, last, grain, fn)：对[first, last)中的每个下标调用fn(i)；
+//      区间按二分递归拆分，直到不超过grain个下标（每块约grain/2到grain个），拆出的一半留给其他线程窃取；
+//      调用线程在等待期间也执行队列中的任务（在工作线程中嵌套调用也不会死锁），
+//      fn抛出的第一个异常在全部下标处理完后重新抛出
+// 设计取舍：队列用互斥量保护（每个队列一把锁，竞争只发生在窃取时），没有实现无锁的Chase-Lev队列
+// 用法：
+//     thread_pool pool;                          // 线程数默认为硬件并发数
+//     auto f = pool.submit([](int x) { return x * 2; }, 21);
+//     pool.parallel_for(0, v.size(), 1024, [&](size_t i) { v[i] *= 2; });
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <algorithm>          // 提供std::max
+#include <atomic>             // 提供std::atomic
+#include <condition_variable> // 提供std::condition_variable
+#include <cstddef>            // 提供size_t
+#include <deque>              // 提供std::deque（每个线程的任务队列）
+#include <exception>          // 提供std::exception_ptr
+#include <future>             // 提供std::future/packaged_task
+#include <memory>             // 提供std::unique_ptr
+#include <mutex>              // 提供std::mutex/lock_guard/unique_lock
+#include <thread>             // 提供std::thread
+#include <tuple>              // 提供std::make_tuple/apply
+#include <type_traits>        // 提供std::invoke_result_t/decay_t
+#include <utility>            // 提供std::move/forward
+#include <vector>
+
+class thread_pool
+{
+public:
+    /**
+     * @brief 创建threads个工作线程（0表示std::thread::hardware_concurrency()）
+     */
+    explicit thread_pool(unsigned threads = 0)
+    {
+        if (threads == 0)
+        {
+            threads = std::max(1U, std::thread::hardware_concurrency());
+        }
+        queues_.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i)
+        {
+            queues_.push_back(std::make_unique<work_queue>());
+        }
+        workers_.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i)
+        {
+            workers_.emplace_back([this, i] { worker_loop(i); });
+        }
+    }
+
+    thread_pool(const thread_pool &) = delete;
+    thread_pool &operator=(const thread_pool &) = delete;
+
+    /**
+     * @brief 执行完所有已提交的任务后结束工作线程
+     */
+    ~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (auto &w : workers_)
+        {
+            w.join();
+        }
+    }
+
+    unsigned size() const { return static_cast<unsigned>(workers_.size()); }
+
+    /**
+     * @brief 提交任务f(args...)，返回其结果的future
+     */
+    template <typename F, typename... Args>
+    auto submit(F &&f, Args &&...args) -> std::future<std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>
+    {
+        using R = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>;
+        std::packaged_task<R()> job(
+            [fn = std::decay_t<F>(std::forward<F>(f)),
+             params = std::make_tuple(std::forward<Args>(args)...)]() mutable {
+                return std::apply(std::move(fn), std::move(params));
+            });
+        std::future<R> result = job.get_future();
+        push(task(std::move(job)));
+        return result;
+    }
+
+    /**
+     * @brief 对[first, last)中的每个下标i调用fn(i)，每个任务最多处理grain个下标
+     */
+    template <typename F>
+    void parallel_for(size_t first, size_t last, size_t grain, F fn)
+    {
+        if (first >= last)
+        {
+            return;
+        }
+        for_state<F> state(fn, std::max<size_t>(grain, 1));
+        run_range(state, first, last);
+        // 等待期间帮忙执行任务，直到所有区间都处理完
+        while (state.pending.load(std::memory_order_acquire) != 0)
+        {
+            if (!run_one())
+            {
+                std::this_thread::yield();
+            }
+        }
+        if (state.error)
+        {
+            std::rethrow_exception(state.error);
+        }
+    }
+
+private:
+    // 只能移动的任务包装（std::function要求可拷贝，装不下packaged_task）
+    class task
+    {
+    public:
+        task() = default;
+
+        template <typename F>
+        explicit task(F f) : impl_(std::make_unique<model<F>>(std::move(f)))
+        {
+        }
+
+        void operator()() { impl_->run(); }
+
+    private:
+        struct concept_t
+        {
+            virtual ~concept_t() = default;
+            virtual void run() = 0;
+        };
+
+        template <typename F>
+        struct model : concept_t
+        {
+            explicit model(F f) : fn(std::move(f)) {}
+            void run() override { fn(); }
+            F fn;
+        };
+
+        std::unique_ptr<concept_t> impl_;
+    };
+
+    struct work_queue
+    {
+        std::mutex mutex;
+        std::deque<task> tasks;
+    };
+
+    // parallel_for的共享状态：pending是尚未处理完的区间数
+    template <typename F>
+    struct for_state
+    {
+        for_state(F &f, size_t g) : fn(f), grain(g) {}
+
+        F &fn;
+        size_t grain;
+        std::atomic<size_t> pending{1}; // 最初只有调用者处理的整个区间
+        std::mutex error_mutex;
+        std::exception_ptr error;
+    };
+
+    // 处理[first, last)：不断二分，把后一半作为任务提交，自己处理前一半
+    template <typename F>
+    void run_range(for_state<F> &state, size_t first, size_t last)
+    {
+        while (last - first > state.grain)
+        {
+            size_t mid = first + (last - first) / 2;
+            state.pending.fetch_add(1, std::memory_order_relaxed);
+            push(task([this, &state, mid, last] { run_range(state, mid, last); }));
+            last = mid;
+        }
+        try
+        {
+            for (size_t i = first; i < last; ++i)
+            {
+                state.fn(i);
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(state.error_mutex);
+            if (!state.error)
+            {
+                state.error = std::current_exception();
+            }
+        }
+        state.pending.fetch_sub(1, std::memory_order_release);
+    }
+
+    // 当前线程所在的线程池与工作线程编号（不是工作线程时pool为nullptr）
+    struct worker_identity
+    {
+        thread_pool *pool = nullptr;
+        size_t index = 0;
+    };
+
+    static worker_identity &current()
+    {
+        thread_local worker_identity id;
+        return id;
+    }
+
+    void push(task t)
+    {
+        const worker_identity &id = current();
+        work_queue &q = id.pool == this ? *queues_[id.index] : injection_;
+        {
+            std::lock_guard<std::mutex> lock(q.mutex);
+            q.tasks.push_back(std::move(t));
+            // 在队列锁内计数，保证取走任务时的减一总在这次加一之后
+            // queued_与sleeping_的读写都使用默认的顺序一致内存序：
+            // 提交者先增加queued_再读sleeping_，工作线程先增加sleeping_再读queued_，二者至少有一方能看到对方
+            queued_.fetch_add(1);
+        }
+        if (sleeping_.load() != 0)
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_); // 与工作线程的检查-等待互斥，避免丢失唤醒
+            wake_.notify_one();
+        }
+    }
+
+    // 取出一个任务：自己的队列尾部 -> 注入队列头部 -> 从其他队列头部窃取
+    bool pop(task &out)
+    {
+        const worker_identity &id = current();
+        const size_t n = queues_.size();
+        if (id.pool == this && take(*queues_[id.index], out, true))
+        {
+            return true;
+        }
+        if (take(injection_, out, false))
+        {
+            return true;
+        }
+        size_t start = id.pool == this ? id.index + 1 : 0;
+        for (size_t k = 0; k < n; ++k)
+        {
+            size_t victim = (start + k) % n;
+            if ((id.pool != this || victim != id.index) && take(*queues_[victim], out, false))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool take(work_queue &q, task &out, bool from_back)
+    {
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty())
+        {
+            return false;
+        }
+        if (from_back)
+        {
+            out = std::move(q.tasks.back());
+            q.tasks.pop_back();
+        }
+        else
+        {
+            out = std::move(q.tasks.front());
+            q.tasks.pop_front();
+        }
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // 执行一个排队中的任务；没有任务时返回false
+    bool run_one()
+    {
+        task t;
+        if (!pop(t))
+        {
+            return false;
+        }
+        t();
+        return true;
+    }
+
+    void worker_loop(size_t index)
+    {
+        current() = worker_identity{this, index};
+        for (;;)
+        {
+            if (run_one())
+            {
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            sleeping_.fetch_add(1);
+            wake_.wait(lock, [this] { return stopping_ || queued_.load() != 0; });
+            sleeping_.fetch_sub(1);
+            if (stopping_ && queued_.load() == 0)
+            {
+                return;
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<work_queue>> queues_; // 每个工作线程一个队列
+    work_queue injection_;                             // 外部线程提交的任务
+    std::vector<std::thread> workers_;
+
+    std::atomic<size_t> queued_{0};     // 所有队列中的任务总数
+    std::atomic<unsigned> sleeping_{0}; // 正在等待的工作线程数
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+};
+
+#endif // THREAD_POOL_HPP
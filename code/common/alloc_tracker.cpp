@@ -0,0 +1,354 @@
+/*
+ * alloc_tracker.h 的实现：替换全局 operator new/delete。
+ *
+ * Using this file requires a C++17-compliant compiler.
+ *
+ * 每块内存前面放一个块头，记录请求的大小和块头到原始地址的偏移，
+ * 这样不带大小的 operator delete 也能知道释放了多少字节。
+ * 块头占 16 字节（对齐到 max_align_t）；对齐要求更高的 new 把块头
+ * 放大到对齐值，保证返回的地址满足对齐。
+ */
+
+#include "alloc_tracker.h"
+
+#include <cstdarg>  // va_list（append 的可变参数）
+#include <cstdio>   // std::vsnprintf/fputs
+#include <cstdlib>  // std::malloc/aligned_alloc/free
+#include <new>      // std::align_val_t/bad_alloc/nothrow_t
+
+namespace alloc_tracker {
+
+namespace {
+
+// 线程局部计数器：平凡类型、零初始化，访问时不需要线程局部对象的初始化检查
+struct counters {
+    std::uint64_t allocations;
+    std::uint64_t deallocations;
+    std::uint64_t bytes;
+    std::int64_t live_bytes;
+    std::int64_t peak_bytes;
+    std::uint64_t histogram[histogram_buckets];
+};
+
+thread_local counters tls_counters;
+
+struct block_header {
+    std::size_t size;    // 请求的字节数
+    std::size_t offset;  // 返回地址到原始地址的距离
+};
+
+constexpr std::size_t default_header = 16;
+static_assert(sizeof(block_header) <= default_header,
+              "block header does not fit");
+
+void record_allocation(std::size_t size) noexcept
+{
+    counters& c = tls_counters;
+    ++c.allocations;
+    c.bytes += size;
+    c.live_bytes += static_cast<std::int64_t>(size);
+    if (c.live_bytes > c.peak_bytes) {
+        c.peak_bytes = c.live_bytes;
+    }
+    ++c.histogram[bucket_of(size)];
+}
+
+void record_deallocation(std::size_t size) noexcept
+{
+    counters& c = tls_counters;
+    ++c.deallocations;
+    c.live_bytes -= static_cast<std::int64_t>(size);
+}
+
+void* tracked_allocate(std::size_t size, std::size_t alignment) noexcept
+{
+    std::size_t header = alignment > default_header ? alignment
+                                                    : default_header;
+    if (size > static_cast<std::size_t>(-1) - 2 * header) {
+        return nullptr;
+    }
+    char* raw;
+    if (alignment > default_header) {
+        // aligned_alloc 要求大小是对齐值的整数倍
+        std::size_t total = (header + size + alignment - 1) / alignment *
+                            alignment;
+        raw = static_cast<char*>(std::aligned_alloc(alignment, total));
+    } else {
+        raw = static_cast<char*>(std::malloc(header + size));
+    }
+    if (raw == nullptr) {
+        return nullptr;
+    }
+    char* ptr = raw + header;
+    auto* hdr = reinterpret_cast<block_header*>(ptr) - 1;
+    hdr->size = size;
+    hdr->offset = header;
+    record_allocation(size);
+    return ptr;
+}
+
+void tracked_deallocate(void* ptr) noexcept
+{
+    if (ptr == nullptr) {
+        return;
+    }
+    auto* hdr = static_cast<block_header*>(ptr) - 1;
+    record_deallocation(hdr->size);
+    std::free(static_cast<char*>(ptr) - hdr->offset);
+}
+
+// 失败时按标准要求调用 new_handler，没有 new_handler 时抛出 bad_alloc
+void* allocate_or_throw(std::size_t size, std::size_t alignment)
+{
+    for (;;) {
+        if (void* ptr = tracked_allocate(size, alignment)) {
+            return ptr;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void* allocate_or_null(std::size_t size, std::size_t alignment) noexcept
+{
+    try {
+        return allocate_or_throw(size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+alloc_stats to_stats(const counters& c) noexcept
+{
+    alloc_stats result{};
+    result.allocations = c.allocations;
+    result.deallocations = c.deallocations;
+    result.bytes = c.bytes;
+    result.live_bytes = c.live_bytes;
+    result.peak_bytes = c.peak_bytes;
+    for (int i = 0; i < histogram_buckets; ++i) {
+        result.histogram[i] = c.histogram[i];
+    }
+    return result;
+}
+
+// 在 buf 中已有的 len 个字符之后追加格式化文本；空间不够时截断，
+// len 最多为 size - 1，之后的追加都不再写入
+__attribute__((format(printf, 4, 5)))
+void append(char* buf, std::size_t size, std::size_t& len,
+            const char* fmt, ...) noexcept
+{
+    if (len + 1 >= size) {
+        return;
+    }
+    va_list args;
+    va_start(args, fmt);
+    int n = std::vsnprintf(buf + len, size - len, fmt, args);
+    va_end(args);
+    if (n > 0) {
+        len += static_cast<std::size_t>(n);
+        if (len >= size) {
+            len = size - 1;
+        }
+    }
+}
+
+} // unnamed namespace
+
+int bucket_of(std::size_t size) noexcept
+{
+    int bucket = 0;
+    for (std::size_t limit = 8; size > limit && bucket < histogram_buckets - 1;
+         limit <<= 1) {
+        ++bucket;
+    }
+    return bucket;
+}
+
+alloc_stats current_stats() noexcept
+{
+    return to_stats(tls_counters);
+}
+
+alloc_scope::alloc_scope(const char* name) noexcept
+    : name_(name), start_(current_stats()), outer_peak_(start_.peak_bytes)
+{
+    // 峰值从当前存活字节数重新开始记录
+    tls_counters.peak_bytes = tls_counters.live_bytes;
+}
+
+alloc_scope::~alloc_scope()
+{
+    if (name_ != nullptr) {
+        report();
+    }
+    // 本作用域内的峰值也是外层作用域的峰值候选
+    if (outer_peak_ > tls_counters.peak_bytes) {
+        tls_counters.peak_bytes = outer_peak_;
+    }
+}
+
+alloc_stats alloc_scope::stats() const noexcept
+{
+    alloc_stats now = current_stats();
+    alloc_stats result{};
+    result.allocations = now.allocations - start_.allocations;
+    result.deallocations = now.deallocations - start_.deallocations;
+    result.bytes = now.bytes - start_.bytes;
+    result.live_bytes = now.live_bytes - start_.live_bytes;
+    result.peak_bytes = now.peak_bytes - start_.live_bytes;
+    for (int i = 0; i < histogram_buckets; ++i) {
+        result.histogram[i] = now.histogram[i] - start_.histogram[i];
+    }
+    return result;
+}
+
+void alloc_scope::report() const noexcept
+{
+    // 先取统计结果再格式化；格式化只用栈上的缓冲区，不会影响统计
+    alloc_stats s = stats();
+    char buf[1024];
+    std::size_t len = 0;
+    buf[0] = '\0';
+    append(buf, sizeof buf, len,
+           "[alloc] %s: %llu allocations, %llu deallocations, %llu bytes, "
+           "peak %lld bytes, live %lld bytes\n",
+           name_ != nullptr ? name_ : "(unnamed)",
+           static_cast<unsigned long long>(s.allocations),
+           static_cast<unsigned long long>(s.deallocations),
+           static_cast<unsigned long long>(s.bytes),
+           static_cast<long long>(s.peak_bytes),
+           static_cast<long long>(s.live_bytes));
+    // 第二行只列出非空的桶，例如 “<=32: 2  <=64: 1”
+    if (s.allocations != 0) {
+        append(buf, sizeof buf, len, "        sizes:");
+        for (int i = 0; i < histogram_buckets; ++i) {
+            if (s.histogram[i] == 0) {
+                continue;
+            }
+            bool last = i == histogram_buckets - 1;
+            append(buf, sizeof buf, len,
+                   last ? "  >%llu: %llu" : "  <=%llu: %llu",
+                   8ULL << (last ? i - 1 : i),
+                   static_cast<unsigned long long>(s.histogram[i]));
+        }
+        append(buf, sizeof buf, len, "\n");
+    }
+    std::fputs(buf, stderr);
+}
+
+} // namespace alloc_tracker
+
+// ---- 替换的全局分配函数 ----
+// 数组版本、不抛异常版本和带大小的 delete 都转到同一组实现
+
+using alloc_tracker::allocate_or_null;
+using alloc_tracker::allocate_or_throw;
+using alloc_tracker::tracked_deallocate;
+
+void* operator new(std::size_t size)
+{
+    return allocate_or_throw(size, 0);
+}
+
+void* operator new[](std::size_t size)
+{
+    return allocate_or_throw(size, 0);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate_or_null(size, 0);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate_or_null(size, 0);
+}
+
+void* operator new(std::size_t size, std::align_val_t al)
+{
+    return allocate_or_throw(size, static_cast<std::size_t>(al));
+}
+
+void* operator new[](std::size_t size, std::align_val_t al)
+{
+    return allocate_or_throw(size, static_cast<std::size_t>(al));
+}
+
+void* operator new(std::size_t size, std::align_val_t al,
+                   const std::nothrow_t&) noexcept
+{
+    return allocate_or_null(size, static_cast<std::size_t>(al));
+}
+
+void* operator new[](std::size_t size, std::align_val_t al,
+                     const std::nothrow_t&) noexcept
+{
+    return allocate_or_null(size, static_cast<std::size_t>(al));
+}
+
+void operator delete(void* ptr) noexcept
+{
+    tracked_deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    tracked_deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    tracked_deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    tracked_deallocate(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    tracked_deallocate(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    tracked_deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+    tracked_deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+    tracked_deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    tracked_deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    tracked_deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t,
+                     const std::nothrow_t&) noexcept
+{
+    tracked_deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t,
+                       const std::nothrow_t&) noexcept
+{
+    tracked_deallocate(ptr);
+}
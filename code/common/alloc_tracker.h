@@ -0,0 +1,73 @@
+/*
+ * 堆分配统计：替换全局 operator new/delete，记录每个线程的分配次数、
+ * 字节数、大小分布和峰值存活字节数。
+ *
+ * Using this file requires a C++17-compliant compiler.
+ *
+ * 用法：把 alloc_tracker.cpp 与演示程序一起编译即可生效，例如
+ *     g++ -std=c++17 string_concat.cpp ../code/common/alloc_tracker.cpp
+ * 然后用 alloc_scope 圈出需要统计的代码：
+ *     {
+ *         alloc_tracker::alloc_scope scope("salute1");
+ *         auto s = salute1(name);
+ *     }   // 离开作用域时把统计结果打印到 stderr
+ *
+ * 计数器都是线程局部变量，记录路径上没有锁和原子操作；因此统计的是
+ * “当前线程”的分配。一个线程释放另一个线程分配的内存时，存活字节数
+ * 记在释放者名下，这时单个线程的存活字节数可能为负。
+ */
+
+#ifndef ALLOC_TRACKER_H
+#define ALLOC_TRACKER_H
+
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::int64_t/uint64_t
+
+namespace alloc_tracker {
+
+// 大小分布的桶数：第 i 个桶统计 (2^(i+2), 2^(i+3)] 字节的分配，
+// 第 0 个桶包括 0 到 8 字节，最后一个桶包括所有更大的分配
+inline constexpr int histogram_buckets = 24;
+
+// 当前线程的分配统计
+struct alloc_stats {
+    std::uint64_t allocations;    // operator new 调用次数
+    std::uint64_t deallocations;  // operator delete 调用次数（不计空指针）
+    std::uint64_t bytes;          // 累计请求的字节数
+    std::int64_t live_bytes;      // 当前存活字节数
+    std::int64_t peak_bytes;      // 存活字节数的峰值
+    std::uint64_t histogram[histogram_buckets];  // 请求大小分布
+};
+
+// 返回当前线程的累计统计（peak_bytes 为当前最内层 alloc_scope 内的峰值）
+alloc_stats current_stats() noexcept;
+
+// 返回大小为 size 的分配所属的桶
+int bucket_of(std::size_t size) noexcept;
+
+// 统计作用域：构造时记录起点，析构时计算这段时间内的增量
+// 作用域可以嵌套；内层作用域的峰值也会计入外层作用域
+class alloc_scope {
+public:
+    // name 为空指针时析构不打印，只能通过 stats() 取结果
+    explicit alloc_scope(const char* name = nullptr) noexcept;
+    ~alloc_scope();
+
+    alloc_scope(const alloc_scope&) = delete;
+    alloc_scope& operator=(const alloc_scope&) = delete;
+
+    // 从作用域开始到现在的增量；peak_bytes 为相对起点的峰值增量
+    alloc_stats stats() const noexcept;
+
+    // 把 stats() 的结果打印到 stderr（不会产生堆分配）
+    void report() const noexcept;
+
+private:
+    const char* name_;
+    alloc_stats start_;
+    std::int64_t outer_peak_;  // 外层作用域在进入本作用域前的峰值
+};
+
+} // namespace alloc_tracker
+
+#endif // ALLOC_TRACKER_H
@@ -0,0 +1,388 @@
+/*
+ * 基于 ostream_range.h 类型萃取的流式 JSON/NDJSON 序列化器。
+ *
+ * Using this file requires a C++17-compliant compiler.
+ *
+ * 类型映射（复用 is_range_v/is_pair_v/is_tuple_like_v/has_output_function_v）：
+ *   - bool                      -> true/false
+ *   - 整数、浮点数               -> 数字（非有限浮点数输出为 null）
+ *   - unsigned char/std::byte   -> 数字（与 ostream_range 一致）
+ *   - char/signed char          -> 长度为 1 的字符串
+ *   - string/string_view/C 字符串 -> 转义后的字符串
+ *   - std::nullptr_t            -> null
+ *   - 键为字符串的关联容器        -> 对象
+ *   - 其他范围                   -> 数组（键不是字符串的 map 成为 [键, 值] 数组的数组）
+ *   - pair/tuple 等类元组对象     -> 数组
+ *   - 其他有 operator<< 的类型    -> 其输出文本作为字符串
+ *
+ * 序列化直接写入接收器（sink），不构造中间的 DOM。接收器只需提供
+ * write(const char*, std::size_t) 成员函数；json_writer 内部带缓冲，
+ * 攒满后成块写给接收器。字符串转义在支持 SSE2 时每次检查 16 字节，
+ * 只在遇到需要转义的字符时才退回逐字节处理。
+ *
+ * 用法：
+ *     json_range::to_json(std::cout, mp);      // 单个 JSON 值
+ *     json_range::to_ndjson(std::cout, rows);  // 每个元素一行
+ */
+
+#ifndef JSON_RANGE_H
+#define JSON_RANGE_H
+
+#include <charconv>     // std::to_chars
+#include <cmath>        // std::isfinite
+#include <cstddef>      // std::byte/nullptr_t/size_t
+#include <cstring>      // std::memcpy
+#include <memory>       // std::unique_ptr
+#include <ostream>      // std::ostream
+#include <sstream>      // std::ostringstream
+#include <string>       // std::string
+#include <string_view>  // std::string_view
+#include <tuple>        // std::get/tuple_size_v
+#include <type_traits>  // std::is_same_v/decay_t/...
+#include <utility>      // std::index_sequence
+
+#ifdef __SSE2__
+#include <emmintrin.h>  // SSE2 intrinsics
+#define JSON_RANGE_HAS_SSE2 1
+#endif
+
+#include "ostream_range.h"
+
+namespace json_range {
+
+using ostream_range::adl_begin;
+using ostream_range::adl_end;
+using ostream_range::has_output_function_v;
+using ostream_range::is_pair_v;
+using ostream_range::is_range_v;
+using ostream_range::is_tuple_like_v;
+
+// 把 JSON 文本写入 std::ostream 的接收器
+class ostream_sink {
+public:
+    explicit ostream_sink(std::ostream& os) : os_(os) {}
+    void write(const char* data, std::size_t size)
+    {
+        os_.write(data, static_cast<std::streamsize>(size));
+    }
+
+private:
+    std::ostream& os_;
+};
+
+// 把 JSON 文本追加到 std::string 的接收器
+class string_sink {
+public:
+    explicit string_sink(std::string& str) : str_(str) {}
+    void write(const char* data, std::size_t size) { str_.append(data, size); }
+
+private:
+    std::string& str_;
+};
+
+// 字符串的字节是否需要转义：控制字符、双引号和反斜杠
+inline bool needs_escape(unsigned char ch)
+{
+    return ch < 0x20 || ch == '"' || ch == '\\';
+}
+
+// 返回 [first, last) 中第一个需要转义的字节位置（逐字节版本）
+inline const char* find_escape_scalar(const char* first, const char* last)
+{
+    for (; first != last; ++first) {
+        if (needs_escape(static_cast<unsigned char>(*first))) {
+            break;
+        }
+    }
+    return first;
+}
+
+// 返回 [first, last) 中第一个需要转义的字节位置（SSE2 每次检查 16 字节）
+inline const char* find_escape(const char* first, const char* last)
+{
+#ifdef JSON_RANGE_HAS_SSE2
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control_max = _mm_set1_epi8(0x1F);
+    while (last - first >= 16) {
+        __m128i chunk =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        // 无符号比较 ch <= 0x1F 等价于 max(ch, 0x1F) == 0x1F
+        __m128i is_control =
+            _mm_cmpeq_epi8(_mm_max_epu8(chunk, control_max), control_max);
+        __m128i hits = _mm_or_si128(
+            is_control, _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                                     _mm_cmpeq_epi8(chunk, backslash)));
+        int mask = _mm_movemask_epi8(hits);
+        if (mask != 0) {
+            return first + __builtin_ctz(static_cast<unsigned>(mask));
+        }
+        first += 16;
+    }
+#endif
+    return find_escape_scalar(first, last);
+}
+
+// 带缓冲的 JSON 写入器，Sink 需提供 write(const char*, std::size_t)
+template <typename Sink>
+class json_writer {
+public:
+    explicit json_writer(Sink& sink)
+        : sink_(sink), buffer_(new char[buffer_size])
+    {
+    }
+    json_writer(const json_writer&) = delete;
+    json_writer& operator=(const json_writer&) = delete;
+    ~json_writer() { flush(); }
+
+    // 写出任意受支持类型的值
+    template <typename T>
+    json_writer& value(const T& val);
+
+    // 写出转义后的 JSON 字符串（含两侧引号）
+    json_writer& string(std::string_view str);
+
+    // 写出原样文本（调用者保证其为合法 JSON 片段）
+    json_writer& raw(std::string_view text)
+    {
+        if (text.size() > buffer_size - used_) {
+            flush();
+            if (text.size() > buffer_size) {
+                sink_.write(text.data(), text.size());
+                return *this;
+            }
+        }
+        std::memcpy(buffer_.get() + used_, text.data(), text.size());
+        used_ += text.size();
+        return *this;
+    }
+
+    json_writer& raw(char ch)
+    {
+        if (used_ == buffer_size) {
+            flush();
+        }
+        buffer_[used_++] = ch;
+        return *this;
+    }
+
+    void flush()
+    {
+        if (used_ != 0) {
+            sink_.write(buffer_.get(), used_);
+            used_ = 0;
+        }
+    }
+
+private:
+    static constexpr std::size_t buffer_size = 65536;
+
+    template <typename T>
+    void number(T val)
+    {
+        char tmp[64];
+        auto result = std::to_chars(tmp, tmp + sizeof tmp, val);
+        raw(std::string_view(tmp, static_cast<std::size_t>(result.ptr - tmp)));
+    }
+
+    template <typename Rng>
+    void range(const Rng& rng);
+
+    template <typename Tup, std::size_t... Is>
+    void tuple(const Tup& tup, std::index_sequence<Is...>);
+
+    Sink& sink_;
+    std::unique_ptr<char[]> buffer_;
+    std::size_t used_ = 0;
+};
+
+// 可以当作字符串的类型
+template <typename T>
+inline constexpr bool is_string_like_v =
+    std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> ||
+    (std::is_pointer_v<std::decay_t<T>> &&
+     (std::is_same_v<std::remove_cv_t<std::remove_pointer_t<std::decay_t<T>>>,
+                     char> ||
+      std::is_same_v<std::remove_cv_t<std::remove_pointer_t<std::decay_t<T>>>,
+                     signed char> ||
+      std::is_same_v<std::remove_cv_t<std::remove_pointer_t<std::decay_t<T>>>,
+                     unsigned char>));
+
+// 检测容器是否定义了 key_type
+template <typename T, typename = void>
+struct has_key_type : std::false_type {};
+template <typename T>
+struct has_key_type<T, std::void_t<typename T::key_type>> : std::true_type {};
+
+template <typename Sink>
+json_writer<Sink>& json_writer<Sink>::string(std::string_view str)
+{
+    static constexpr char hex_digits[] = "0123456789abcdef";
+    raw('"');
+    const char* first = str.data();
+    const char* last = first + str.size();
+    while (first != last) {
+        const char* stop = find_escape(first, last);
+        raw(std::string_view(first, static_cast<std::size_t>(stop - first)));
+        if (stop == last) {
+            break;
+        }
+        unsigned char ch = static_cast<unsigned char>(*stop);
+        switch (ch) {
+        case '"':
+            raw("\\\"");
+            break;
+        case '\\':
+            raw("\\\\");
+            break;
+        case '\b':
+            raw("\\b");
+            break;
+        case '\f':
+            raw("\\f");
+            break;
+        case '\n':
+            raw("\\n");
+            break;
+        case '\r':
+            raw("\\r");
+            break;
+        case '\t':
+            raw("\\t");
+            break;
+        default: {
+            char esc[] = {'\\', 'u', '0', '0', hex_digits[ch >> 4],
+                          hex_digits[ch & 0xF]};
+            raw(std::string_view(esc, sizeof esc));
+        }
+        }
+        first = stop + 1;
+    }
+    raw('"');
+    return *this;
+}
+
+template <typename Sink>
+template <typename T>
+json_writer<Sink>& json_writer<Sink>::value(const T& val)
+{
+    if constexpr (std::is_same_v<T, bool>) {
+        raw(val ? std::string_view("true") : std::string_view("false"));
+    } else if constexpr (std::is_same_v<T, std::nullptr_t>) {
+        raw("null");
+    } else if constexpr (std::is_same_v<T, char> ||
+                         std::is_same_v<T, signed char>) {
+        char ch = static_cast<char>(val);
+        string(std::string_view(&ch, 1));
+    } else if constexpr (std::is_same_v<T, unsigned char> ||
+                         std::is_same_v<T, std::byte>) {
+        number(static_cast<unsigned>(val));
+    } else if constexpr (std::is_integral_v<T>) {
+        number(val);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        if (std::isfinite(val)) {
+            number(val);  // 最短且可精确往返的表示
+        } else {
+            raw("null");
+        }
+    } else if constexpr (is_string_like_v<T>) {
+        if constexpr (std::is_pointer_v<std::decay_t<T>>) {
+            string(reinterpret_cast<const char*>(val));
+        } else {
+            string(val);
+        }
+    } else if constexpr (is_range_v<const T&> && !has_output_function_v<T>) {
+        range(val);
+    } else if constexpr (is_tuple_like_v<T> && !is_range_v<T>) {
+        tuple(val, std::make_index_sequence<std::tuple_size_v<T>>{});
+    } else {
+        static_assert(has_output_function_v<T>,
+                      "type cannot be serialized to JSON");
+        std::ostringstream oss;
+        oss << val;
+        string(oss.str());
+    }
+    return *this;
+}
+
+template <typename Sink>
+template <typename Rng>
+void json_writer<Sink>::range(const Rng& rng)
+{
+    using element_type = std::decay_t<decltype(*adl_begin(rng))>;
+    constexpr bool is_object = [] {
+        if constexpr (is_pair_v<element_type> && has_key_type<Rng>::value) {
+            return is_string_like_v<
+                std::decay_t<typename element_type::first_type>>;
+        } else {
+            return false;
+        }
+    }();
+
+    raw(is_object ? '{' : '[');
+    bool first = true;
+    auto last = adl_end(rng);
+    for (auto it = adl_begin(rng); it != last; ++it) {
+        if (!first) {
+            raw(',');
+        }
+        first = false;
+        if constexpr (is_object) {
+            value((*it).first);
+            raw(':');
+            value((*it).second);
+        } else {
+            value(*it);
+        }
+    }
+    raw(is_object ? '}' : ']');
+}
+
+template <typename Sink>
+template <typename Tup, std::size_t... Is>
+void json_writer<Sink>::tuple(const Tup& tup, std::index_sequence<Is...>)
+{
+    using std::get;
+    raw('[');
+    ((Is != 0 ? (void)raw(',') : (void)0, value(get<Is>(tup))), ...);
+    raw(']');
+}
+
+// 把单个值序列化为 JSON 写入 os
+template <typename T>
+void to_json(std::ostream& os, const T& val)
+{
+    ostream_sink sink(os);
+    json_writer<ostream_sink> writer(sink);
+    writer.value(val);
+}
+
+// 把单个值序列化为 JSON 字符串
+template <typename T>
+std::string to_json_string(const T& val)
+{
+    std::string result;
+    string_sink sink(result);
+    {
+        json_writer<string_sink> writer(sink);
+        writer.value(val);
+    }
+    return result;
+}
+
+// 把范围中的每个元素序列化为一行 JSON（NDJSON）写入 os
+template <typename Rng>
+void to_ndjson(std::ostream& os, const Rng& rng)
+{
+    ostream_sink sink(os);
+    json_writer<ostream_sink> writer(sink);
+    auto last = adl_end(rng);
+    for (auto it = adl_begin(rng); it != last; ++it) {
+        writer.value(*it);
+        writer.raw('\n');
+    }
+}
+
+} // namespace json_range
+
+#endif // JSON_RANGE_H
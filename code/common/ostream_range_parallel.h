@@ -0,0 +1,176 @@
+/*
+ * ostream_range 的并行分块输出扩展。
+ *
+ * Using this file requires a C++17-compliant compiler.
+ *
+ * 对于元素数以百万计的随机访问范围，把范围切成互不相交的块，
+ * 由多个线程分别格式化到各自的缓冲区，再按块的顺序写入目标流。
+ * 每个块使用与目标流相同的格式状态（copyfmt），并沿用 ostream_range.h
+ * 的 output_element（默认格式时使用 ostream_range_plan.h 的格式计划），
+ * 因此输出与串行的 os << rng 逐字节一致。
+ *
+ * 用法：
+ *     std::cout << ostream_range::parallel(vec) << '\n';      // 线程数取硬件并发数
+ *     std::cout << ostream_range::parallel(vec, 4) << '\n';   // 指定 4 个线程
+ *
+ * 为控制内存占用，输出按“轮”进行：每轮最多格式化
+ * 线程数 × chunk_size 个元素，写出后再开始下一轮。
+ */
+
+#ifndef OSTREAM_RANGE_PARALLEL_H
+#define OSTREAM_RANGE_PARALLEL_H
+
+#include <algorithm>    // std::min
+#include <cstddef>      // std::size_t
+#include <exception>    // std::exception_ptr/current_exception/rethrow_exception
+#include <iterator>     // std::iterator_traits/random_access_iterator_tag
+#include <ostream>      // std::ostream
+#include <sstream>      // std::ostringstream
+#include <string>       // std::string
+#include <string_view>  // std::string_view
+#include <thread>       // std::thread
+#include <type_traits>  // std::decay_t/is_base_of_v
+#include <vector>       // std::vector
+
+#include "ostream_range.h"
+#include "ostream_range_plan.h"
+
+namespace ostream_range {
+
+// parallel() 返回的轻量包装：保存范围引用和并行参数
+template <typename Rng>
+class parallel_range {
+public:
+    // 每个块默认包含的元素个数：太小则线程调度开销占比高，太大则内存占用高
+    static constexpr std::size_t default_chunk_size = 65536;
+
+    parallel_range(const Rng& rng, unsigned threads, std::size_t chunk_size)
+        : rng_(rng), threads_(threads), chunk_size_(chunk_size)
+    {
+    }
+
+    const Rng& get() const { return rng_; }
+    unsigned threads() const { return threads_; }
+    std::size_t chunk_size() const { return chunk_size_; }
+
+private:
+    const Rng& rng_;
+    unsigned threads_;
+    std::size_t chunk_size_;
+};
+
+// threads 为 0 时使用 std::thread::hardware_concurrency()
+template <typename Rng>
+parallel_range<Rng> parallel(
+    const Rng& rng, unsigned threads = 0,
+    std::size_t chunk_size = parallel_range<Rng>::default_chunk_size)
+{
+    using iterator = decltype(adl_begin(rng));
+    static_assert(
+        std::is_base_of_v<
+            std::random_access_iterator_tag,
+            typename std::iterator_traits<iterator>::iterator_category>,
+        "parallel() requires a random-access range");
+    if (threads == 0) {
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    return parallel_range<Rng>(rng, threads,
+                               std::max<std::size_t>(chunk_size, 1));
+}
+
+// 把 [first, last) 中的元素格式化到 os，index 是 first 在整个范围中的下标，
+// 分隔符规则与 operator<< 相同："{ " 在第一个元素前，其余元素前为 ", "
+template <typename Rng, typename It>
+void output_chunk(std::ostream& os, const Rng& rng, It first, It last,
+                  std::size_t index)
+{
+    using element_type = std::decay_t<decltype(*first)>;
+    if constexpr (is_plannable_v<Rng>) {
+        if (has_default_format(os)) {
+            using entry_plan = typename range_plan<const Rng>::entry_plan;
+            plan_buffer buf(os);
+            for (; first != last; ++first, ++index) {
+                buf.append(index == 0 ? std::string_view(" ")
+                                      : std::string_view(", "));
+                entry_plan::write(buf, *first);
+                buf.element_done();
+            }
+            buf.flush();
+            return;
+        }
+    }
+    for (; first != last; ++first, ++index) {
+        if (index != 0) {
+            os << ", ";
+        } else {
+            os << ' ';
+        }
+        output_element(os, *first, rng, is_pair<element_type>{});
+    }
+}
+
+} // namespace ostream_range
+
+// 并行输出函数：元素不足一块时直接串行输出；只有一个线程时
+// 仍按块输出（不创建线程），便于和多线程的结果对比扩展性
+template <typename Rng>
+std::ostream& operator<<(std::ostream& os,
+                         const ostream_range::parallel_range<Rng>& pr)
+{
+    const Rng& rng = pr.get();
+    auto first = ostream_range::adl_begin(rng);
+    const std::size_t size =
+        static_cast<std::size_t>(ostream_range::adl_end(rng) - first);
+    const std::size_t chunk_size = pr.chunk_size();
+    if (size <= chunk_size) {
+        return os << rng;
+    }
+
+    std::vector<std::string> buffers(pr.threads());
+    std::vector<std::exception_ptr> errors(pr.threads());
+    auto format_chunk = [&](unsigned slot, std::size_t begin,
+                            std::size_t end) {
+        try {
+            std::ostringstream oss;
+            oss.copyfmt(os);
+            oss.width(0);            // 宽度只作用于 '{'，不能带进块内
+            oss.exceptions(std::ios_base::goodbit);
+            ostream_range::output_chunk(oss, rng, first + begin, first + end,
+                                        begin);
+            buffers[slot] = std::move(oss).str();
+        } catch (...) {
+            errors[slot] = std::current_exception();
+        }
+    };
+
+    os << '{';
+    for (std::size_t round_begin = 0; round_begin < size;
+         round_begin += chunk_size * pr.threads()) {
+        std::vector<std::thread> workers;
+        unsigned used = 0;
+        for (std::size_t begin = round_begin;
+             used < pr.threads() && begin < size; ++used, begin += chunk_size) {
+            std::size_t end = std::min(begin + chunk_size, size);
+            if (used + 1 == pr.threads() || end == size) {
+                // 本轮最后一块由当前线程自己完成
+                format_chunk(used, begin, end);
+            } else {
+                workers.emplace_back(format_chunk, used, begin, end);
+            }
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        for (unsigned slot = 0; slot < used; ++slot) {
+            if (errors[slot]) {
+                std::rethrow_exception(errors[slot]);
+            }
+            os.write(buffers[slot].data(),
+                     static_cast<std::streamsize>(buffers[slot].size()));
+        }
+    }
+    os << " }";
+    return os;
+}
+
+#endif // OSTREAM_RANGE_PARALLEL_H
@@ -0,0 +1,371 @@
+/*
+ * ostream_range 的“编译期格式计划”扩展。
+ *
+ * Using this file requires a C++17-compliant compiler.
+ *
+ * ostream_range.h 在运行期通过一连串小的 os << 调用输出每个元素（括号、
+ * 分隔符、引号各一次）。本头文件在编译期把元素类型（例如
+ * map<int, vector<pair<string, double>>>）展开为一棵由 value_plan/element_plan
+ * 组成的类型树：每个节点只由固定的字面量片段和值槽组成，所有分派都在编译期完成。
+ * 运行期只需按计划把字面量和数值（std::to_chars）追加进缓冲区，
+ * 再成块写入流中。
+ *
+ * 用法：
+ *     std::cout << ostream_range::planned(mp) << '\n';
+ *
+ * 输出与 std::cout << mp 完全一致。若流的格式状态不是默认值（精度、宽度、
+ * 进制、locale 等被修改），或者类型中含有计划无法表示的元素（例如用户
+ * 自定义的 operator<<），则自动退回到普通的 operator<<。
+ */
+
+#ifndef OSTREAM_RANGE_PLAN_H
+#define OSTREAM_RANGE_PLAN_H
+
+#include <charconv>     // std::to_chars/chars_format
+#include <cstddef>      // std::byte/size_t
+#include <ios>          // std::ios_base
+#include <locale>       // std::locale
+#include <ostream>      // std::ostream
+#include <string>       // std::string
+#include <string_view>  // std::string_view
+#include <tuple>        // std::get/tuple_element_t/tuple_size_v
+#include <type_traits>  // std::is_same_v/decay_t/...
+#include <utility>      // std::declval/index_sequence
+
+#include "ostream_range.h"
+
+namespace ostream_range {
+
+// 格式计划的输出缓冲区：计划把字面量和值追加到这里，
+// 累积到一定大小后一次性写入底层流
+class plan_buffer {
+public:
+    explicit plan_buffer(std::ostream& os) : os_(os)
+    {
+        buf_.reserve(flush_threshold + flush_threshold / 4);
+    }
+
+    void append(char ch) { buf_.push_back(ch); }
+    void append(std::string_view sv) { buf_.append(sv.data(), sv.size()); }
+
+    template <typename T>
+    void append_number(T value)
+    {
+        char tmp[64];
+        std::to_chars_result result;
+        if constexpr (std::is_floating_point_v<T>) {
+            // 与 printf("%.6g") 等价，即 ostream 的默认浮点格式
+            result = std::to_chars(tmp, tmp + sizeof tmp, value,
+                                   std::chars_format::general, 6);
+        } else {
+            result = std::to_chars(tmp, tmp + sizeof tmp, value);
+        }
+        buf_.append(tmp, result.ptr);
+    }
+
+    // 每写完一个元素调用一次：缓冲区足够大时才真正写流
+    void element_done()
+    {
+        if (buf_.size() >= flush_threshold) {
+            flush();
+        }
+    }
+
+    void flush()
+    {
+        if (!buf_.empty()) {
+            os_.write(buf_.data(),
+                      static_cast<std::streamsize>(buf_.size()));
+            buf_.clear();
+        }
+    }
+
+private:
+    static constexpr std::size_t flush_threshold = 16384;
+
+    std::ostream& os_;
+    std::string buf_;
+};
+
+// 检测容器是否定义了 key_type（与 output_element 的 SFINAE 条件一致）
+template <typename T, typename = void>
+struct has_key_type : std::false_type {};
+template <typename T>
+struct has_key_type<T, std::void_t<typename T::key_type>> : std::true_type {};
+template <typename T>
+inline constexpr bool has_key_type_v = has_key_type<T>::value;
+
+// 可以直接当作 C 字符串/字符串视图输出的类型
+template <typename T>
+inline constexpr bool is_plan_string_v =
+    std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> ||
+    (std::is_pointer_v<std::decay_t<T>> &&
+     (std::is_same_v<std::remove_cv_t<std::remove_pointer_t<std::decay_t<T>>>,
+                     char> ||
+      std::is_same_v<std::remove_cv_t<std::remove_pointer_t<std::decay_t<T>>>,
+                     signed char> ||
+      std::is_same_v<std::remove_cv_t<std::remove_pointer_t<std::decay_t<T>>>,
+                     unsigned char>));
+
+template <typename T>
+inline constexpr bool is_plan_char_v =
+    std::is_same_v<T, char> || std::is_same_v<T, signed char> ||
+    std::is_same_v<T, unsigned char>;
+
+template <typename T>
+struct value_plan;
+template <typename T>
+struct element_plan;
+
+// 不支持的类型：supported 为 false，整个计划退回到 operator<<
+struct unsupported_plan {
+    static constexpr bool supported = false;
+    template <typename T>
+    static void write(plan_buffer&, const T&) {}
+};
+
+// 数值槽：对应 os << value
+template <typename T>
+struct number_plan {
+    static constexpr bool supported = true;
+    static void write(plan_buffer& buf, T value)
+    {
+        if constexpr (std::is_same_v<T, bool>) {
+            buf.append(value ? '1' : '0');
+        } else if constexpr (is_plan_char_v<T>) {
+            buf.append(static_cast<char>(value));
+        } else {
+            buf.append_number(value);
+        }
+    }
+};
+
+// 原样字符串槽：对应 os << str
+struct string_plan {
+    static constexpr bool supported = true;
+    static void write(plan_buffer& buf, std::string_view sv)
+    {
+        buf.append(sv);
+    }
+    template <typename Ch>
+    static void write(plan_buffer& buf, const Ch* s)
+    {
+        buf.append(std::string_view(reinterpret_cast<const char*>(s)));
+    }
+};
+
+// 带引号的字符串槽：对应 output_element 中的 '"' << element << '"'
+template <typename Inner>
+struct quoted_plan {
+    static constexpr bool supported = Inner::supported;
+    static constexpr char quote = '"';
+    template <typename T>
+    static void write(plan_buffer& buf, const T& value)
+    {
+        buf.append(quote);
+        Inner::write(buf, value);
+        buf.append(quote);
+    }
+};
+
+// 带单引号的字符槽：对应 output_element 中的 '\'' << element << '\''
+template <typename T>
+struct quoted_char_plan {
+    static constexpr bool supported = true;
+    static void write(plan_buffer& buf, T value)
+    {
+        buf.append('\'');
+        buf.append(static_cast<char>(value));
+        buf.append('\'');
+    }
+};
+
+// 字节槽：unsigned char/std::byte 作为无符号整数输出
+template <typename T>
+struct byte_plan {
+    static constexpr bool supported = true;
+    static void write(plan_buffer& buf, T value)
+    {
+        buf.append_number(static_cast<unsigned>(value));
+    }
+};
+
+// 关联容器中的键值对：key " => " value
+template <typename Pair>
+struct map_entry_plan {
+    using first_plan = element_plan<std::decay_t<decltype(
+        std::declval<const Pair&>().first)>>;
+    using second_plan = element_plan<std::decay_t<decltype(
+        std::declval<const Pair&>().second)>>;
+    static constexpr bool supported =
+        first_plan::supported && second_plan::supported;
+    static constexpr std::string_view arrow = " => ";
+
+    static void write(plan_buffer& buf, const Pair& pr)
+    {
+        first_plan::write(buf, pr.first);
+        buf.append(arrow);
+        second_plan::write(buf, pr.second);
+    }
+};
+
+// 范围："{ " e1 ", " e2 ... " }"，空范围为 "{}"
+// Rng 可以带 const；不带 const 时可以输出 filter_view 这类只能非 const 遍历的视图
+template <typename Rng>
+struct range_plan {
+    using element_type =
+        std::decay_t<decltype(*adl_begin(std::declval<Rng&>()))>;
+    using entry_plan =
+        std::conditional_t<is_pair_v<element_type> &&
+                               has_key_type_v<std::remove_cv_t<Rng>>,
+                           map_entry_plan<element_type>,
+                           element_plan<element_type>>;
+    static constexpr bool supported = entry_plan::supported;
+    static constexpr std::string_view open = "{ ";
+    static constexpr std::string_view separator = ", ";
+    static constexpr std::string_view close = " }";
+    static constexpr std::string_view empty = "{}";
+
+    static void write(plan_buffer& buf, Rng& rng)
+    {
+        auto it = adl_begin(rng);
+        auto last = adl_end(rng);
+        if (it == last) {
+            buf.append(empty);
+            return;
+        }
+        buf.append(open);
+        entry_plan::write(buf, *it);
+        buf.element_done();
+        for (++it; it != last; ++it) {
+            buf.append(separator);
+            entry_plan::write(buf, *it);
+            buf.element_done();
+        }
+        buf.append(close);
+    }
+};
+
+// 类元组对象："(" m1 ", " m2 ... ")"
+template <typename Tup,
+          typename = std::make_index_sequence<std::tuple_size_v<Tup>>>
+struct tuple_plan;
+template <typename Tup, std::size_t... Is>
+struct tuple_plan<Tup, std::index_sequence<Is...>> {
+    static constexpr bool supported =
+        (element_plan<std::decay_t<std::tuple_element_t<Is, Tup>>>::supported
+         && ... && true);
+    static constexpr std::string_view separator = ", ";
+
+    static void write(plan_buffer& buf, const Tup& tup)
+    {
+        using std::get;
+        buf.append('(');
+        ((buf.append(Is != 0 ? separator : std::string_view()),
+          element_plan<std::decay_t<std::tuple_element_t<Is, Tup>>>::write(
+              buf, get<Is>(tup))),
+         ...);
+        buf.append(')');
+    }
+};
+
+// 选择 os << value 语义下的计划（与 ostream_range.h 的重载决议一致）
+// T 可以带 const，它决定范围以 const 还是非 const 方式遍历
+template <typename T>
+constexpr auto select_value_plan()
+{
+    using U = std::remove_cv_t<T>;
+    if constexpr (is_range_v<T&> && !has_output_function_v<U>) {
+        return range_plan<T>{};
+    } else if constexpr (is_tuple_like_v<U> && !is_range_v<U>) {
+        return tuple_plan<U>{};
+    } else if constexpr (is_plan_string_v<U>) {
+        return string_plan{};
+    } else if constexpr (std::is_arithmetic_v<U> &&
+                         !std::is_same_v<U, wchar_t> &&
+                         !std::is_same_v<U, char16_t> &&
+                         !std::is_same_v<U, char32_t>) {
+        return number_plan<U>{};
+    } else {
+        return unsupported_plan{};
+    }
+}
+
+// 选择 output_element 语义下的计划（字符加单引号、字符串加双引号）
+template <typename T>
+constexpr auto select_element_plan()
+{
+    if constexpr (std::is_same_v<T, char> || std::is_same_v<T, signed char>) {
+        return quoted_char_plan<T>{};
+    } else if constexpr (std::is_same_v<T, unsigned char> ||
+                         std::is_same_v<T, std::byte>) {
+        return byte_plan<T>{};
+    }
+#ifndef OSTREAM_RANGE_NO_STRING_QUOTE
+    else if constexpr (is_plan_string_v<T>) {
+        return quoted_plan<string_plan>{};
+    }
+#endif
+    else {
+        return select_value_plan<const T>();
+    }
+}
+
+template <typename T>
+struct value_plan : decltype(select_value_plan<T>()) {};
+template <typename T>
+struct element_plan : decltype(select_element_plan<T>()) {};
+
+// 类型 T 是否能完全由格式计划输出
+template <typename T>
+inline constexpr bool is_plannable_v = value_plan<T>::supported;
+
+// 流是否处于默认格式状态（只有这时计划的输出才与 operator<< 一致）
+inline bool has_default_format(const std::ostream& os)
+{
+    return os.flags() == (std::ios_base::skipws | std::ios_base::dec) &&
+           os.precision() == 6 && os.width() == 0 &&
+           os.getloc() == std::locale::classic();
+}
+
+// planned() 返回的轻量包装，只保存引用（Rng 可能带 const）
+template <typename Rng>
+class planned_range {
+public:
+    explicit planned_range(Rng& rng) : rng_(rng) {}
+    Rng& get() const { return rng_; }
+
+private:
+    Rng& rng_;
+};
+
+// 参数可以是临时视图：包装对象只在所在的完整表达式内使用
+template <typename Rng>
+planned_range<std::remove_reference_t<Rng>> planned(Rng&& rng)
+{
+    static_assert(is_range_v<Rng&> ||
+                      is_tuple_like_v<std::remove_cv_t<
+                          std::remove_reference_t<Rng>>>,
+                  "planned() expects a range or a tuple-like object");
+    return planned_range<std::remove_reference_t<Rng>>(rng);
+}
+
+} // namespace ostream_range
+
+// 格式计划的输出函数：条件满足时按计划输出，否则退回普通 operator<<
+template <typename Rng>
+std::ostream& operator<<(std::ostream& os,
+                         const ostream_range::planned_range<Rng>& pr)
+{
+    if constexpr (ostream_range::is_plannable_v<Rng>) {
+        if (ostream_range::has_default_format(os)) {
+            ostream_range::plan_buffer buf(os);
+            ostream_range::value_plan<Rng>::write(buf, pr.get());
+            buf.flush();
+            return os;
+        }
+    }
+    return os << pr.get();
+}
+
+#endif // OSTREAM_RANGE_PLAN_H
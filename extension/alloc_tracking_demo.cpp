@@ -0,0 +1,140 @@
+// To compile: g++ -std=c++17 -O2 alloc_tracking_demo.cpp ../code/common/alloc_tracker.cpp -o alloc_tracking_demo
+// To run:     ./alloc_tracking_demo
+
+// 程序功能：用alloc_tracker统计堆分配，验证两个常见说法：
+//           1. salute1（分步+=）与salute2（单次表达式+）的分配次数差异（见string_concat.cpp）
+//           2. String拷贝构造/拷贝赋值各需一次分配，而string_arena中的String几乎不访问全局堆
+// 统计结果由alloc_scope在离开作用域时打印到stderr；程序同时检查关键计数，不符时返回1
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../code/common/alloc_tracker.h"
+#include "../code/01 - c and cpp basics/string.hpp"
+
+using namespace std;
+using alloc_tracker::alloc_scope;
+
+// 与string_concat.cpp中的两种写法相同
+string salute1(const string &name)
+{
+    string msg = "Hi, ";
+    msg += name;
+    msg += ", how are you today?";
+    return msg;
+}
+
+string salute2(const string &name)
+{
+    return string{"Hi, "} + name + ", how are you today?";
+}
+
+static int failures = 0;
+
+// 检查计数是否符合预期
+static void expect(const char *what, unsigned long long actual,
+                   unsigned long long expected)
+{
+    if (actual != expected)
+    {
+        cerr << "不符合预期: " << what << " = " << actual
+             << "，预期为 " << expected << '\n';
+        ++failures;
+    }
+}
+
+int main()
+{
+    cout.setf(ios::unitbuf); // 让stdout与stderr上的统计结果按顺序交错输出
+
+    cout << "============= 1. salute1 vs salute2 =============\n";
+    // salute2中后两次+的左操作数是右值，operator+直接在其缓冲区上追加，
+    // 因此两种写法的分配次数取决于扩容次数，而不是临时对象的个数
+    for (const string name : {"Al", "Alice", "Bartholomew-Maximilian"})
+    {
+        cout << "name = \"" << name << "\"（结果长度 "
+             << salute1(name).size() << "）\n";
+        unsigned long long n1, n2;
+        string r1, r2;
+        {
+            alloc_scope scope("  salute1");
+            r1 = salute1(name);
+            n1 = scope.stats().allocations;
+        }
+        {
+            alloc_scope scope("  salute2");
+            r2 = salute2(name);
+            n2 = scope.stats().allocations;
+        }
+        cout << "  salute1分配 " << n1 << " 次，salute2分配 " << n2 << " 次\n";
+        if (r1 != r2)
+        {
+            cerr << "两种写法的结果不同\n";
+            ++failures;
+        }
+    }
+
+    cout << "\n============= 2. String的拷贝 =============\n";
+    String src("a string that is definitely longer than any SSO buffer");
+    {
+        alloc_scope scope("  copy construct");
+        String copy(src);
+        auto s = scope.stats();
+        expect("拷贝构造的分配次数", s.allocations, 1);
+        expect("拷贝构造的分配字节数", s.bytes, src.size() + 1);
+    }
+    {
+        String dst("short");
+        alloc_scope scope("  copy assign");
+        dst = src;
+        auto s = scope.stats();
+        // 先分配新内存、再释放旧内存
+        expect("拷贝赋值的分配次数", s.allocations, 1);
+        expect("拷贝赋值的释放次数", s.deallocations, 1);
+    }
+    {
+        alloc_scope scope("  vector<String> push_back x100");
+        vector<String> v;
+        for (int i = 0; i < 100; ++i)
+        {
+            v.push_back(src); // 扩容时没有移动构造，旧元素逐个拷贝
+        }
+    }
+    {
+        alloc_scope scope("  vector<String> reserve + push_back x100");
+        vector<String> v;
+        v.reserve(100);
+        for (int i = 0; i < 100; ++i)
+        {
+            v.push_back(src);
+        }
+        expect("reserve后push_back的分配次数", scope.stats().allocations, 101);
+    }
+    {
+        alloc_scope scope("  string_arena x100");
+        string_arena arena(64 * 1024);
+        vector<String> v;
+        v.reserve(100);
+        for (int i = 0; i < 100; ++i)
+        {
+            v.emplace_back(src.c_str(), arena);
+        }
+        // 一次vector缓冲区 + 一次内存池的初始缓冲区
+        expect("string_arena的分配次数", scope.stats().allocations, 2);
+    }
+
+    cout << "\n============= 3. 嵌套作用域的峰值 =============\n";
+    {
+        alloc_scope outer("  outer");
+        {
+            alloc_scope inner("  inner");
+            vector<char> big(1 << 20); // 作用域结束时已释放，但计入峰值
+        }
+        vector<char> small(1 << 10);
+        auto s = outer.stats();
+        expect("外层作用域的峰值", s.peak_bytes, 1 << 20);
+        expect("外层作用域的存活字节数", s.live_bytes, 1 << 10);
+    }
+
+    cout << (failures == 0 ? "\n所有检查通过\n" : "\n存在不符合预期的计数\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,179 @@
+// To compile: g++ -std=c++20 -O2 -pthread async_line_reader_benchmark.cpp -o async_line_reader_bench
+// To run:     ./async_line_reader_bench [行数] [块大小(KB)]
+
+// 程序功能：对比两种处理日志文件的方式（仅适用于POSIX系统）
+//   任务：统计级别为ERROR的行数以及这些行的总长度（filter + transform）
+//   数据：生成一个临时日志文件，每行形如"2024-05-01 12:00:00 ERROR net: request failed id=123"，约两成是ERROR
+//   方式：
+//     1. getline：先把所有行读进vector<string>，再对容器使用std::views::filter/transform
+//     2. read_lines：async_line_reader.hpp的协程生成器，边读边处理，每行是指向块缓冲区的string_view；
+//        分别测试io_uring（可用时）与后台线程两种读取方式
+// 另外用很小的块（让大量行跨越块边界）核对两种读取方式下read_lines与getline得到的每一行完全相同，
+// 并检查只取第一行（views::take(1)）后提前销毁生成器是安全的；结束时删除临时文件
+#include <chrono>   // 提供计时功能
+#include <cstdio>   // 提供std::remove
+#include <cstdlib>  // 提供std::atol
+#include <fstream>  // 提供std::ifstream/ofstream
+#include <iomanip>  // 提供setw/setprecision
+#include <iostream>
+#include <ranges>   // 提供std::views::filter/transform
+#include <string>
+#include <string_view>
+#include <unistd.h> // 提供getpid
+#include <vector>
+#include "../code/10 - views/async_line_reader.hpp"
+
+using namespace std;
+
+struct summary
+{
+    size_t count = 0;
+    size_t bytes = 0;
+
+    bool operator==(const summary &) const = default;
+};
+
+bool is_error(string_view line)
+{
+    return line.find(" ERROR ") != string_view::npos;
+}
+
+// 对任意产出行（string或string_view）的范围做同样的视图管道
+template <typename Range>
+summary summarize(Range &&lines)
+{
+    summary s;
+    // generator只可移动，必须以右值接入管道
+    auto pipeline = forward<Range>(lines) | views::filter([](string_view line) { return is_error(line); }) |
+                    views::transform([](string_view line) { return line.size(); });
+    for (size_t len : pipeline)
+    {
+        ++s.count;
+        s.bytes += len;
+    }
+    return s;
+}
+
+void make_log(const string &path, size_t lines)
+{
+    static const char *levels[] = {"INFO", "DEBUG", "WARN", "ERROR", "INFO"};
+    static const char *modules[] = {"net", "db", "auth", "cache"};
+    static const char *messages[] = {"request failed", "connection reset by peer", "ok",
+                                     "slow query took too long to complete", "retrying"};
+    ofstream out(path, ios::binary);
+    unsigned x = 12345;
+    for (size_t i = 0; i < lines; ++i)
+    {
+        x = x * 1103515245 + 12345; // 简单的线性同余伪随机数，保证每次生成相同的文件
+        unsigned r = x >> 16;
+        out << "2024-05-01 " << setfill('0') << setw(2) << (i / 3600) % 24 << ':' << setw(2)
+            << (i / 60) % 60 << ':' << setw(2) << i % 60 << ' ' << levels[r % 5] << ' '
+            << modules[(r / 5) % 4] << ": " << messages[(r / 20) % 5] << " id=" << i << '\n';
+    }
+    // 最后一行不带换行符
+    out << "2024-05-02 00:00:00 ERROR net: last line without newline";
+}
+
+vector<string> read_all(const string &path)
+{
+    ifstream in(path, ios::binary);
+    vector<string> lines;
+    string line;
+    while (getline(in, line))
+    {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+template <typename Fn>
+double best_ms(int repeats, Fn fn)
+{
+    double best = 0;
+    for (int r = 0; r < repeats; ++r)
+    {
+        auto start = chrono::steady_clock::now();
+        fn();
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        best = r == 0 ? ms : min(best, ms);
+    }
+    return best;
+}
+
+int main(int argc, char *argv[])
+{
+    long lines = argc > 1 ? atol(argv[1]) : 2000000;
+    long block_kb = argc > 2 ? atol(argv[2]) : 1024;
+    if (lines <= 0 || block_kb <= 0)
+    {
+        cerr << "用法: " << argv[0] << " [行数] [块大小(KB)]\n";
+        return 1;
+    }
+
+    const string path = "/tmp/async_line_reader_" + to_string(getpid()) + ".log";
+    make_log(path, static_cast<size_t>(lines));
+    int status = 0;
+    try
+    {
+        const size_t block = static_cast<size_t>(block_kb) * 1024;
+        vector<string> expected = read_all(path);
+        summary by_getline;
+        // 第一次运行之后文件在页缓存中，各种方式都不受磁盘速度影响
+        double getline_ms = best_ms(3, [&] { by_getline = summarize(read_all(path)); });
+        cout << expected.size() << " 行，块大小 " << block_kb << " KB，ERROR行 " << by_getline.count
+             << " 行（共 " << by_getline.bytes << " 字节）\n";
+        cout << fixed << setprecision(2);
+        cout << "  " << left << setw(39) << "getline -> vector<string> -> views:" << right << setw(9) << getline_ms << " ms\n";
+
+        for (bool use_io_uring : {true, false})
+        {
+            const string backend = async_file(path, use_io_uring).backend();
+            if (use_io_uring && backend != "io_uring")
+            {
+                cout << "  （io_uring不可用，只测试后台线程）\n";
+                continue;
+            }
+
+            // 正确性：7字节的块使几乎每一行都跨越块边界
+            size_t i = 0;
+            bool same = true;
+            for (string_view line : read_lines(path, 7, use_io_uring))
+            {
+                same = same && i < expected.size() && line == expected[i];
+                ++i;
+            }
+            if (!same || i != expected.size())
+            {
+                cerr << "read_lines（" << backend << "）的结果与getline不一致\n";
+                status = 1;
+            }
+
+            // 提前结束：第一行产出时下一块的读取已经发起，销毁生成器要等它完成后才能释放缓冲区
+            for (string_view line : read_lines(path, block, use_io_uring) | views::take(1))
+            {
+                if (line != expected[0])
+                {
+                    cerr << "read_lines（" << backend << "）| views::take(1)的结果不正确\n";
+                    status = 1;
+                }
+            }
+
+            summary by_reader;
+            double reader_ms = best_ms(3, [&] { by_reader = summarize(read_lines(path, block, use_io_uring)); });
+            cout << "  " << left << setw(39) << "read_lines (" + backend + ") -> views:" << right << setw(9)
+                 << reader_ms << " ms  (" << getline_ms / reader_ms << "x)\n";
+            if (!(by_getline == by_reader))
+            {
+                cerr << "read_lines（" << backend << "）与getline的统计结果不一致\n";
+                status = 1;
+            }
+        }
+    }
+    catch (const exception &e)
+    {
+        cerr << e.what() << '\n';
+        status = 1;
+    }
+    remove(path.c_str());
+    return status;
+}
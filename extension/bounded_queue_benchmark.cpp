@@ -0,0 +1,237 @@
+// To compile: g++ -std=c++17 -O2 -pthread bounded_queue_benchmark.cpp -o bounded_queue_bench
+// To run:     ./bounded_queue_bench [元素总数] [队列容量]
+
+// 程序功能：bounded_queue.hpp中无锁队列的吞吐量与延迟测试
+//   队列：spsc_queue（只测1个生产者1个消费者）、mpmc_queue、互斥量保护的deque（对照组）
+//   线程：生产者数 = 消费者数 = 1、2、4、8、16
+//   批大小：1（try_push/try_pop）与32（push_n/pop_n）
+//   吞吐量 = 元素总数 / 从开始生产到最后一个元素被取走的时间
+//   延迟 = 元素从入队前到被取走经过的时间，统计p50与p99
+//   队列满/空时让出CPU（std::this_thread::yield）；线程数超过物理核数时，延迟主要取决于线程调度
+// 每个配置都核对所有元素恰好被取走一次（个数与总和）
+#include <algorithm> // 提供std::nth_element
+#include <atomic>    // 提供std::atomic
+#include <chrono>    // 提供计时功能
+#include <cstdint>   // 提供uint64_t等
+#include <cstdlib>   // 提供std::atol
+#include <deque>     // 提供std::deque（对照组）
+#include <iomanip>   // 提供setw/setprecision
+#include <iostream>
+#include <mutex>     // 提供std::mutex（对照组）
+#include <string>
+#include <thread>    // 提供std::thread
+#include <vector>
+#include "../code/16 - concurrency programming/bounded_queue.hpp"
+
+using namespace std;
+
+struct item
+{
+    uint64_t value;
+    int64_t pushed_ns; // 入队前的时间戳
+};
+
+int64_t now_ns()
+{
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief 对照组：互斥量保护的有界deque，接口与无锁队列相同
+ */
+template <typename T>
+class mutex_queue
+{
+public:
+    explicit mutex_queue(size_t capacity) : capacity_(capacity) {}
+
+    template <typename It>
+    size_t push_n(It first, size_t n)
+    {
+        lock_guard<mutex> lock(mutex_);
+        size_t k = min(n, capacity_ - items_.size());
+        for (size_t i = 0; i < k; ++i, ++first)
+        {
+            items_.push_back(std::move(*first));
+        }
+        return k;
+    }
+
+    template <typename Out>
+    size_t pop_n(Out out, size_t n)
+    {
+        lock_guard<mutex> lock(mutex_);
+        size_t k = min(n, items_.size());
+        for (size_t i = 0; i < k; ++i, ++out)
+        {
+            *out = std::move(items_.front());
+            items_.pop_front();
+        }
+        return k;
+    }
+
+private:
+    size_t capacity_;
+    mutex mutex_;
+    deque<T> items_;
+};
+
+struct result
+{
+    double ms;
+    double p50_ns;
+    double p99_ns;
+    bool ok;
+};
+
+template <typename Queue>
+result run(size_t capacity, unsigned producers, unsigned consumers, size_t batch, size_t total)
+{
+    Queue q(capacity);
+    atomic<size_t> consumed{0};
+    atomic<uint64_t> sum{0};
+    vector<vector<uint32_t>> latencies(consumers);
+    vector<thread> threads;
+
+    auto start = chrono::steady_clock::now();
+    for (unsigned p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&, p] {
+            vector<item> buf(batch);
+            // 生产者p负责值p, p + producers, p + 2 * producers, ...
+            for (size_t v = p; v < total;)
+            {
+                size_t n = 0;
+                int64_t t = now_ns();
+                for (; n < batch && v < total; ++n, v += producers)
+                {
+                    buf[n] = item{v, t};
+                }
+                for (size_t done = 0; done < n;)
+                {
+                    size_t k = q.push_n(buf.begin() + done, n - done);
+                    done += k;
+                    if (k == 0)
+                    {
+                        this_thread::yield();
+                    }
+                }
+            }
+        });
+    }
+    for (unsigned c = 0; c < consumers; ++c)
+    {
+        threads.emplace_back([&, c] {
+            vector<item> buf(batch);
+            vector<uint32_t> &lat = latencies[c];
+            lat.reserve(total / consumers + batch);
+            uint64_t local_sum = 0;
+            while (consumed.load(memory_order_relaxed) < total)
+            {
+                size_t k = q.pop_n(buf.begin(), batch);
+                if (k == 0)
+                {
+                    this_thread::yield();
+                    continue;
+                }
+                int64_t t = now_ns();
+                for (size_t i = 0; i < k; ++i)
+                {
+                    local_sum += buf[i].value;
+                    int64_t d = t - buf[i].pushed_ns;
+                    lat.push_back(static_cast<uint32_t>(min<int64_t>(d, UINT32_MAX)));
+                }
+                consumed.fetch_add(k, memory_order_relaxed);
+            }
+            sum.fetch_add(local_sum);
+        });
+    }
+    for (auto &t : threads)
+    {
+        t.join();
+    }
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    vector<uint32_t> all;
+    all.reserve(total);
+    for (auto &lat : latencies)
+    {
+        all.insert(all.end(), lat.begin(), lat.end());
+    }
+    auto percentile = [&all](double p) {
+        auto nth = all.begin() + static_cast<ptrdiff_t>(p * static_cast<double>(all.size() - 1));
+        nth_element(all.begin(), nth, all.end());
+        return static_cast<double>(*nth);
+    };
+    bool ok = all.size() == total && consumed.load() == total &&
+              sum.load() == static_cast<uint64_t>(total) * (total - 1) / 2;
+    return {ms, percentile(0.5), percentile(0.99), ok};
+}
+
+template <typename Queue>
+bool report(const char *name, size_t capacity, unsigned threads, size_t batch, size_t total)
+{
+    result r = run<Queue>(capacity, threads, threads, batch, total);
+    cout << "  " << left << setw(12) << name << right << setw(4) << threads << setw(6) << batch << fixed
+         << setprecision(2) << setw(10) << total / r.ms / 1e3 << " M/秒" << setw(12) << setprecision(0)
+         << r.p50_ns << " ns" << setw(12) << r.p99_ns << " ns\n";
+    if (!r.ok)
+    {
+        cerr << name << "：元素丢失或重复\n";
+    }
+    return r.ok;
+}
+
+int main(int argc, char *argv[])
+{
+    long total = argc > 1 ? atol(argv[1]) : 1000000;
+    long capacity = argc > 2 ? atol(argv[2]) : 1024;
+    if (total <= 0 || capacity <= 0)
+    {
+        cerr << "用法: " << argv[0] << " [元素总数] [队列容量]\n";
+        return 1;
+    }
+
+    // 单线程下的基本语义：容量取整、满/空、批量操作的部分成功
+    {
+        mpmc_queue<int> m(3);
+        spsc_queue<int> s(3);
+        int in[6] = {1, 2, 3, 4, 5, 6}, out[6] = {};
+        bool ok = m.capacity() == 4 && m.push_n(in, 6) == 4 && !m.try_push(7) && m.pop_n(out, 3) == 3 &&
+                  out[2] == 3 && m.try_push(8) && m.pop_n(out, 6) == 2 && out[0] == 4 && out[1] == 8 &&
+                  !m.try_pop(out[0]);
+        ok = ok && s.capacity() == 4 && s.push_n(in, 6) == 4 && !s.try_push(7) && s.pop_n(out, 3) == 3 &&
+             out[2] == 3 && s.try_push(8) && s.pop_n(out, 6) == 2 && out[0] == 4 && out[1] == 8 &&
+             !s.try_pop(out[0]);
+        // try_push失败时不能移走调用方的元素
+        mpmc_queue<string> ms(2);
+        spsc_queue<string> ss(2);
+        string a = "a", b = "b", c = "a long string that is not stored inline";
+        ok = ok && ms.try_push(std::move(a)) && ms.try_push(std::move(b)) && !ms.try_push(std::move(c)) &&
+             c.size() == 39 && ms.try_pop(a) && ms.try_push(std::move(c)) && ms.try_pop(a) && ms.try_pop(a) &&
+             a.size() == 39;
+        c = a;
+        ok = ok && ss.try_push(string("a")) && ss.try_push(c) && !ss.try_push(std::move(c)) && c.size() == 39;
+        if (!ok)
+        {
+            cerr << "队列的基本语义不正确\n";
+            return 1;
+        }
+    }
+
+    const size_t n = static_cast<size_t>(total);
+    const size_t cap = static_cast<size_t>(capacity);
+    cout << n << " 个元素，队列容量 " << cap << "，硬件线程数 " << thread::hardware_concurrency() << '\n';
+    cout << "  队列     生产/消费  批    吞吐量              p50             p99\n";
+    bool ok = true;
+    for (size_t batch : {size_t(1), size_t(32)})
+    {
+        ok &= report<spsc_queue<item>>("spsc", cap, 1, batch, n);
+        for (unsigned threads : {1u, 2u, 4u, 8u, 16u})
+        {
+            ok &= report<mpmc_queue<item>>("mpmc", cap, threads, batch, n);
+            ok &= report<mutex_queue<item>>("mutex+deque", cap, threads, batch, n);
+        }
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,144 @@
+// To compile: g++ -std=c++17 -O2 chunked_log_benchmark.cpp -o chunked_log_bench
+// To run:     ./chunked_log_bench [元素个数]   （默认1亿个uint32_t，三种容器共需约1.6GB内存）
+
+// 程序功能：对比vector、deque与chunked_log（chunked_log.hpp）在“追加 + 反向扫描”负载下的速度
+//   1. 追加：逐个push_back（vector不预留空间，增长时重新分配并搬动全部元素）
+//   2. 反向扫描求和：
+//      - 与reverseOutput方法1相同的--it循环、方法2相同的rbegin()/rend()循环（三种容器都测）
+//      - chunked_log::for_each_chunk_reverse：按块反向，块内是可以向量化的指针循环
+// 所有扫描的和必须一致；另外检查追加过程中chunked_log已有元素的地址保持不变
+#include <chrono>  // 提供计时功能
+#include <cstdint> // 提供uint32_t/uint64_t
+#include <cstdlib> // 提供std::atol
+#include <deque>
+#include <iomanip> // 提供setw/setprecision
+#include <iostream>
+#include <vector>
+#include "../code/08 - iterators/chunked_log.hpp"
+
+using namespace std;
+
+using log_type = chunked_log<uint32_t>;
+
+template <typename Fn>
+auto timed(const char *name, size_t n, Fn fn)
+{
+    auto start = chrono::steady_clock::now();
+    auto result = fn();
+    auto elapsed = chrono::steady_clock::now() - start;
+    double ns = chrono::duration<double, nano>(elapsed).count();
+    cout << "  " << left << setw(36) << name << right << fixed << setprecision(1)
+         << setw(10) << ns / 1e6 << " ms" << setprecision(3) << setw(8) << ns / n
+         << " ns/元素\n";
+    return result;
+}
+
+// 与reverseOutput方法1相同：普通迭代器从end()往前
+template <typename C>
+uint64_t sum_decrement(const C &c)
+{
+    uint64_t total = 0;
+    for (auto it = c.end(); it != c.begin();)
+    {
+        --it;
+        total += *it;
+    }
+    return total;
+}
+
+// 与reverseOutput方法2相同：反向迭代器
+template <typename C>
+uint64_t sum_reverse(const C &c)
+{
+    uint64_t total = 0;
+    for (auto it = c.rbegin(); it != c.rend(); ++it)
+    {
+        total += *it;
+    }
+    return total;
+}
+
+uint64_t sum_chunks_reverse(const log_type &log)
+{
+    uint64_t total = 0;
+    log.for_each_chunk_reverse([&total](const uint32_t *first, const uint32_t *last) {
+        uint64_t chunk = 0;
+        while (last != first)
+        {
+            chunk += *--last;
+        }
+        total += chunk;
+    });
+    return total;
+}
+
+int main(int argc, char *argv[])
+{
+    long arg = argc > 1 ? atol(argv[1]) : 100000000;
+    if (arg <= 0)
+    {
+        cerr << "用法: " << argv[0] << " [元素个数]\n";
+        return 1;
+    }
+    const size_t n = static_cast<size_t>(arg);
+    auto value = [](size_t i) { return static_cast<uint32_t>(i * 2654435761u); };
+
+    cout << n << " 个uint32_t，chunked_log每块 " << log_type::chunk_size << " 个元素\n";
+    cout << "追加：\n";
+    vector<uint32_t> v;
+    deque<uint32_t> d;
+    log_type log;
+    timed("vector::push_back", n, [&] {
+        for (size_t i = 0; i < n; ++i)
+            v.push_back(value(i));
+        return 0;
+    });
+    timed("deque::push_back", n, [&] {
+        for (size_t i = 0; i < n; ++i)
+            d.push_back(value(i));
+        return 0;
+    });
+    const uint32_t *first_element = nullptr;
+    timed("chunked_log::push_back", n, [&] {
+        log.push_back(value(0));
+        first_element = &log.front();
+        for (size_t i = 1; i < n; ++i)
+            log.push_back(value(i));
+        return 0;
+    });
+    if (first_element != &log.front() || *first_element != value(0))
+    {
+        cerr << "追加后chunked_log的元素地址发生了变化\n";
+        return 1;
+    }
+
+    cout << "反向扫描求和：\n";
+    uint64_t sums[] = {
+        timed("vector（--it）", n, [&] { return sum_decrement(v); }),
+        timed("vector（rbegin/rend）", n, [&] { return sum_reverse(v); }),
+        timed("deque（--it）", n, [&] { return sum_decrement(d); }),
+        timed("deque（rbegin/rend）", n, [&] { return sum_reverse(d); }),
+        timed("chunked_log（--it）", n, [&] { return sum_decrement(log); }),
+        timed("chunked_log（rbegin/rend）", n, [&] { return sum_reverse(log); }),
+        timed("chunked_log（for_each_chunk_reverse）", n, [&] { return sum_chunks_reverse(log); }),
+    };
+    for (uint64_t s : sums)
+    {
+        if (s != sums[0])
+        {
+            cerr << "反向扫描的结果不一致\n";
+            return 1;
+        }
+    }
+
+    // 逐元素反向回调与正向迭代的顺序检查
+    size_t i = n;
+    bool ordered = true;
+    log.for_each_reverse([&](uint32_t x) { ordered = ordered && x == value(--i); });
+    if (!ordered || i != 0 || log[n / 2] != value(n / 2) || *(log.begin() + n / 3) != value(n / 3))
+    {
+        cerr << "chunked_log的访问顺序错误\n";
+        return 1;
+    }
+    return 0;
+}
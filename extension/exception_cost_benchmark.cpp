@@ -0,0 +1,170 @@
+// To compile: g++ -std=c++17 -O2 -pthread exception_cost_benchmark.cpp -o exception_cost_bench
+// To run:     ./exception_cost_bench [每组抛出次数] > exception_cost.csv
+
+// 程序功能：在stack_unwind.cpp的基础上测量异常的代价，输出可直接绘图的CSV（stdout），进度信息输出到stderr
+//   1. latency：单线程下throw到catch的延迟，随调用深度（1~256层）和每层带析构函数的局部对象个数变化；
+//      同时测量同样深度下正常返回的耗时作为基线
+//   2. contention：多个线程同时抛出异常时的吞吐量。栈展开需要查找每一帧的展开信息，
+//      运行时库在查找时会加全局锁（如dl_iterate_phdr），线程越多，竞争越明显
+// CSV列：test,threads,depth,locals_per_frame,iterations,ns_per_throw,ns_per_return,throws_per_sec
+#include <array>   // 提供std::array（每层的局部对象）
+#include <atomic>  // 提供std::atomic（线程同时起跑）
+#include <chrono>  // 提供计时功能
+#include <cstdio>  // 提供printf/fprintf
+#include <cstdlib> // 提供std::atol
+#include <thread>  // 提供std::thread
+#include <vector>
+
+using namespace std;
+
+#define NOINLINE __attribute__((noinline))
+
+// 与stack_unwind.cpp中的Obj对应：析构函数有副作用，编译器不能省略
+thread_local long destroyed = 0;
+class Obj
+{
+public:
+    Obj() {}
+    ~Obj() { ++destroyed; }
+};
+
+/**
+ * @brief 递归depth层，每层有Locals个局部对象；最内层在n == 42时抛出异常
+ */
+template <size_t Locals>
+NOINLINE int chain(int depth, int n)
+{
+    array<Obj, Locals> locals;
+    (void)locals;
+    if (depth <= 1)
+    {
+        if (n == 42)
+        {
+            throw "life, the universe and everything";
+        }
+        return n;
+    }
+    int result = chain<Locals>(depth - 1, n);
+    // 编译器屏障：阻止没有局部对象时把递归改写成循环，保证每一层都是真实的栈帧
+    __asm__ __volatile__("" : "+r"(result));
+    return result + 1;
+}
+
+/**
+ * @brief 调用iterations次chain，返回平均每次的纳秒数；n为42时每次都抛出并在这里捕获
+ */
+template <size_t Locals>
+double time_calls(int depth, int n, long iterations)
+{
+    long caught = 0;
+    long sum = 0;
+    auto start = chrono::steady_clock::now();
+    for (long i = 0; i < iterations; ++i)
+    {
+        try
+        {
+            sum += chain<Locals>(depth, n);
+        }
+        catch (const char *)
+        {
+            ++caught;
+        }
+    }
+    auto elapsed = chrono::steady_clock::now() - start;
+    if ((n == 42 && caught != iterations) || (n != 42 && caught != 0) || sum < 0)
+    {
+        fprintf(stderr, "结果不正确：深度 %d\n", depth);
+        exit(1);
+    }
+    return chrono::duration<double, nano>(elapsed).count() / iterations;
+}
+
+template <size_t Locals>
+void latency(long iterations)
+{
+    for (int depth = 1; depth <= 256; depth *= 2)
+    {
+        long destroyed_before = destroyed;
+        double throw_ns = time_calls<Locals>(depth, 42, iterations);
+        // 每次栈展开都必须析构所有帧中的全部局部对象
+        if (destroyed - destroyed_before != static_cast<long>(Locals) * depth * iterations)
+        {
+            fprintf(stderr, "析构次数不正确：深度 %d\n", depth);
+            exit(1);
+        }
+        double return_ns = time_calls<Locals>(depth, 0, iterations);
+        printf("latency,1,%d,%zu,%ld,%.1f,%.1f,%.0f\n", depth, Locals, iterations,
+               throw_ns, return_ns, 1e9 / throw_ns);
+    }
+    fprintf(stderr, "latency：每层 %zu 个局部对象，完成\n", Locals);
+}
+
+void contention(long iterations)
+{
+    constexpr int depth = 16;
+    constexpr size_t locals = 1;
+    unsigned hw = thread::hardware_concurrency();
+    for (unsigned threads = 1; threads <= 16; threads *= 2)
+    {
+        atomic<unsigned> ready{0};
+        atomic<bool> go{false};
+        vector<double> per_thread_ns(threads);
+        vector<thread> workers;
+        for (unsigned t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&, t] {
+                // 所有线程就绪后同时开始，保证抛出是并发发生的
+                ready.fetch_add(1);
+                while (!go.load())
+                {
+                    this_thread::yield();
+                }
+                per_thread_ns[t] = time_calls<locals>(depth, 42, iterations);
+            });
+        }
+        while (ready.load() != threads)
+        {
+            this_thread::yield();
+        }
+        auto start = chrono::steady_clock::now();
+        go.store(true);
+        for (auto &w : workers)
+        {
+            w.join();
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        double avg_ns = 0;
+        for (double ns : per_thread_ns)
+        {
+            avg_ns += ns / threads;
+        }
+        printf("contention,%u,%d,%zu,%ld,%.1f,,%.0f\n", threads, depth, locals,
+               iterations, avg_ns, threads * iterations / seconds);
+        if (threads > hw)
+        {
+            fprintf(stderr, "contention：%u 个线程超过了硬件线程数 %u\n",
+                    threads, hw);
+        }
+    }
+    fprintf(stderr, "contention：完成\n");
+}
+
+int main(int argc, char *argv[])
+{
+    long iterations = argc > 1 ? atol(argv[1]) : 10000;
+    if (iterations <= 0)
+    {
+        fprintf(stderr, "用法: %s [每组抛出次数]\n", argv[0]);
+        return 1;
+    }
+
+    printf("test,threads,depth,locals_per_frame,iterations,ns_per_throw,"
+           "ns_per_return,throws_per_sec\n");
+    latency<0>(iterations);
+    latency<1>(iterations);
+    latency<4>(iterations);
+    latency<16>(iterations);
+    contention(iterations);
+    return 0;
+}
@@ -0,0 +1,167 @@
+// To compile: g++ -std=c++17 -O2 expected_benchmark.cpp -o expected_bench
+// To run:     ./expected_bench [每组调用次数]
+
+// 程序功能：对比stack_unwind.cpp中的throw/catch与expected.hpp中基于返回值的错误传播
+// 测试方法：foo(n)在n == 42时失败；调用链共depth层，每层都有一个带析构函数的局部对象Obj
+//           （与stack_unwind.cpp相同），失败时需要逐层析构后把错误交给最外层调用者
+//           对每个（失败率，调用深度）组合，两种实现处理同一组输入，核对结果后输出ns/次调用
+#include <chrono>  // 提供计时功能
+#include <cstdlib> // 提供std::atol
+#include <iomanip> // 提供setw/setprecision
+#include <iostream>
+#include <random>  // 提供随机数（生成失败的输入）
+#include <vector>
+#include "../code/02 - object lifetime and raii/expected.hpp"
+
+using namespace std;
+using err::expected;
+
+#define NOINLINE __attribute__((noinline))
+
+// 局部对象：析构函数有可观察的副作用，编译器不能省略
+long destroyed = 0;
+class Obj
+{
+public:
+    Obj() {}
+    ~Obj() { ++destroyed; }
+};
+
+// ===== 异常版本 =====
+NOINLINE void foo_throw(int n)
+{
+    Obj obj;
+    if (n == 42)
+    {
+        throw "life, the universe and everything";
+    }
+}
+
+NOINLINE int chain_throw(int depth, int n)
+{
+    Obj obj;
+    if (depth == 0)
+    {
+        foo_throw(n);
+        return n;
+    }
+    return chain_throw(depth - 1, n) + 1;
+}
+
+// ===== expected版本 =====
+NOINLINE expected<void, const char *> foo_expected(int n)
+{
+    Obj obj;
+    if (n == 42)
+    {
+        return err::unexpected("life, the universe and everything");
+    }
+    return {};
+}
+
+NOINLINE expected<int, const char *> chain_expected(int depth, int n)
+{
+    Obj obj;
+    if (depth == 0)
+    {
+        EXPECTED_CHECK(foo_expected(n));
+        return n;
+    }
+    EXPECTED_TRY(int v, chain_expected(depth - 1, n));
+    return v + 1;
+}
+
+struct outcome
+{
+    long sum = 0;    // 成功调用的返回值之和
+    long errors = 0; // 失败的调用数
+    double ns = 0;   // 平均每次调用的耗时
+};
+
+template <typename Fn>
+outcome measure(const vector<int> &inputs, Fn fn)
+{
+    outcome out;
+    auto start = chrono::steady_clock::now();
+    for (int n : inputs)
+    {
+        fn(n, out);
+    }
+    auto elapsed = chrono::steady_clock::now() - start;
+    out.ns = chrono::duration<double, nano>(elapsed).count() / inputs.size();
+    return out;
+}
+
+int main(int argc, char *argv[])
+{
+    long calls = argc > 1 ? atol(argv[1]) : 200000;
+    if (calls <= 0)
+    {
+        cerr << "用法: " << argv[0] << " [每组调用次数]\n";
+        return 1;
+    }
+
+    const double failure_rates[] = {0.0, 0.001, 0.01, 0.05, 0.2};
+    const int depths[] = {1, 4, 16, 64};
+
+    cout << "每组调用 " << calls << " 次（单位：ns/次调用）\n";
+    cout << setw(10) << "失败率" << setw(8) << "深度" << setw(12) << "throw"
+         << setw(12) << "expected" << setw(10) << "比值" << '\n';
+
+    mt19937 gen(12345);
+    for (double rate : failure_rates)
+    {
+        // 按失败率生成输入：失败的调用传入42，其余传入0~41
+        bernoulli_distribution fail(rate);
+        uniform_int_distribution<int> ok_value(0, 41);
+        vector<int> inputs(calls);
+        for (auto &n : inputs)
+        {
+            n = fail(gen) ? 42 : ok_value(gen);
+        }
+
+        for (int depth : depths)
+        {
+            long destroyed_before = destroyed;
+            outcome t = measure(inputs, [depth](int n, outcome &out) {
+                try
+                {
+                    out.sum += chain_throw(depth, n);
+                }
+                catch (const char *)
+                {
+                    ++out.errors;
+                }
+            });
+            long destroyed_throw = destroyed - destroyed_before;
+
+            destroyed_before = destroyed;
+            outcome e = measure(inputs, [depth](int n, outcome &out) {
+                auto r = chain_expected(depth, n);
+                if (r)
+                {
+                    out.sum += *r;
+                }
+                else
+                {
+                    ++out.errors;
+                }
+            });
+            long destroyed_expected = destroyed - destroyed_before;
+
+            // 两种实现必须得到相同的结果，并析构相同数量的局部对象
+            if (t.sum != e.sum || t.errors != e.errors ||
+                destroyed_throw != destroyed_expected)
+            {
+                cerr << "结果不一致：失败率 " << rate << "，深度 " << depth << '\n';
+                return 1;
+            }
+
+            cout << setw(9) << fixed << setprecision(1) << rate * 100 << '%'
+                 << setw(8) << depth << setw(12) << setprecision(1) << t.ns
+                 << setw(12) << e.ns << setw(9) << setprecision(2) << t.ns / e.ns
+                 << "x\n";
+        }
+    }
+    return 0;
+}
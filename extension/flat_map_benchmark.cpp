@@ -0,0 +1,266 @@
+// To compile: g++ -std=c++20 -O2 flat_map_benchmark.cpp -o flat_map_bench
+// To run:     ./flat_map_bench [元素个数]
+
+// 程序功能：在std::map<int, string>与flat_map<int, string>上运行视图示例中的同一组管道，对比耗时
+//   构建：N个键打乱顺序后插入（map逐个insert，flat_map批量插入后一次排序）
+//   管道（与cxx20_views.cpp、cxx20_views_bad_transform.cpp、views_pipeline_order_performance.cpp相同）：
+//     1. reverse | filter(键为偶数) | values
+//     2. transform(取键) | filter(偶数)
+//     3. filter(键为偶数) | reverse | values（不合理的顺序，filter被求值两遍）
+//     4. values（flat_map另测直接遍历values()数组）
+//   另测N次随机查找（find）
+// 另外检查构造/复制值时（包括批量插入的排序阶段）抛出异常后flat_map的键、值数组仍然一致、原有元素不变
+// 每个管道把结果累加成校验值（值的总长度或键的和），两种容器的结果必须相同
+#include <algorithm> // 提供std::shuffle
+#include <chrono>    // 提供计时功能
+#include <cstdlib>   // 提供std::atol
+#include <iomanip>   // 提供setw/setprecision
+#include <iostream>
+#include <map>       // 提供std::map
+#include <random>    // 提供std::mt19937
+#include <ranges>    // 提供C++20范围视图
+#include <string>
+#include <utility>   // 提供std::pair
+#include <vector>
+#include "../code/10 - views/flat_map.hpp"
+
+using namespace std;
+
+// flat_map满足视图需要的迭代器要求
+static_assert(ranges::random_access_range<flat_map<int, string>>);
+static_assert(ranges::random_access_range<decltype(declval<flat_map<int, string> &>() | views::values)>);
+static_assert(is_same_v<ranges::range_reference_t<decltype(declval<flat_map<int, string> &>() | views::values)>,
+                        string &>);
+
+// 值为负数时构造/复制抛出异常，用于检查异常安全；
+// copies_left不小于0时，再复制copies_left次之后的那次复制抛出异常
+// 声明了复制构造函数，没有移动构造函数：std::move(p)也是复制，可能抛出异常
+struct picky
+{
+    int x;
+    static inline int copies_left = -1;
+
+    explicit picky(int v) : x(v)
+    {
+        if (x < 0)
+            throw x;
+    }
+    picky(const picky &other) : picky(other.x)
+    {
+        if (copies_left >= 0 && copies_left-- == 0)
+            throw -2;
+    }
+    picky &operator=(const picky &) = default;
+};
+
+template <typename Fn>
+double best_ms(int repeats, Fn fn)
+{
+    double best = 0;
+    for (int r = 0; r < repeats; ++r)
+    {
+        auto start = chrono::steady_clock::now();
+        fn();
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        best = r == 0 ? ms : min(best, ms);
+    }
+    return best;
+}
+
+auto even_key = [](const auto &pr) { return pr.first % 2 == 0; };
+
+template <typename Map>
+size_t reverse_filter_values(const Map &mp)
+{
+    size_t total = 0;
+    for (const string &s : mp | views::reverse | views::filter(even_key) | views::values)
+    {
+        total += s.size();
+    }
+    return total;
+}
+
+template <typename Map>
+size_t transform_filter(const Map &mp)
+{
+    size_t total = 0;
+    for (int k : mp | views::transform([](const auto &pr) { return pr.first; }) |
+                     views::filter([](int num) { return num % 2 == 0; }))
+    {
+        total += static_cast<size_t>(k);
+    }
+    return total;
+}
+
+template <typename Map>
+size_t filter_reverse_values(const Map &mp)
+{
+    size_t total = 0;
+    for (const string &s : mp | views::filter(even_key) | views::reverse | views::values)
+    {
+        total += s.size();
+    }
+    return total;
+}
+
+template <typename Values>
+size_t all_values(const Values &values)
+{
+    size_t total = 0;
+    for (const string &s : values)
+    {
+        total += s.size();
+    }
+    return total;
+}
+
+template <typename Map>
+size_t find_all(const Map &mp, const vector<int> &queries)
+{
+    size_t total = 0;
+    for (int q : queries)
+    {
+        auto it = mp.find(q);
+        if (it != mp.end())
+        {
+            total += it->second.size();
+        }
+    }
+    return total;
+}
+
+void report(const char *name, double map_ms, double flat_ms)
+{
+    cout << "  " << left << setw(32) << name << right << fixed << setprecision(2) << setw(10) << map_ms
+         << " ms" << setw(10) << flat_ms << " ms" << setw(8) << map_ms / flat_ms << "x\n";
+}
+
+int main(int argc, char *argv[])
+{
+    long n = argc > 1 ? atol(argv[1]) : 1000000;
+    if (n <= 0)
+    {
+        cerr << "用法: " << argv[0] << " [元素个数]\n";
+        return 1;
+    }
+
+    // 基本语义：批量插入时保留已有的值，单个插入/删除后仍然有序
+    {
+        flat_map<int, string> fm{{3, "three"}, {1, "one"}, {3, "THREE"}};
+        vector<pair<int, string>> more{{2, "two"}, {1, "ONE"}, {4, "four"}};
+        fm.insert(more.begin(), more.end());
+        fm[0] = "zero";
+        fm.erase(4);
+        string joined;
+        for (auto [k, v] : fm | views::reverse)
+        {
+            joined += to_string(k) + v;
+        }
+        if (joined != "3three2two1one0zero" || fm.at(3) != "three" || fm.contains(4))
+        {
+            cerr << "flat_map的基本语义不正确：" << joined << '\n';
+            return 1;
+        }
+    }
+
+    // 异常安全：构造或复制值时抛出异常，键数组与值数组仍然一样长，原有元素不变
+    {
+        flat_map<int, picky> fm{{1, picky(10)}, {3, picky(30)}};
+        vector<pair<int, picky>> more{{2, picky(20)}, {4, picky(40)}, {5, picky(50)}};
+        more[1].second.x = -1; // 复制时抛出异常
+        int thrown = 0;
+        try
+        {
+            fm.try_emplace(2, -1);
+        }
+        catch (int)
+        {
+            ++thrown;
+        }
+        try
+        {
+            fm.insert(more.begin(), more.end());
+        }
+        catch (int)
+        {
+            ++thrown;
+        }
+        if (thrown != 2 || fm.keys().size() != 2 || fm.values().size() != 2 || fm.at(3).x != 30 ||
+            fm.contains(2))
+        {
+            cerr << "flat_map在异常后状态不一致\n";
+            return 1;
+        }
+    }
+
+    // 异常安全：排序、去重时复制值抛出异常（已reserve，追加时不会重新分配），原有的键和值不变
+    {
+        flat_map<string, picky> fm;
+        fm.reserve(10);
+        fm.try_emplace("bbb", 2);
+        fm.try_emplace("aaa", 1);
+        vector<pair<string, picky>> more{{"ccc: a long key that is not stored inline", picky(3)}};
+        picky::copies_left = 2; // 追加时复制1次，sort_and_unique中第2次复制值时抛出
+        bool thrown = false;
+        try
+        {
+            fm.insert(more.begin(), more.end());
+        }
+        catch (int)
+        {
+            thrown = true;
+        }
+        picky::copies_left = -1;
+        if (!thrown || fm.size() != 2 || fm.keys()[0] != "aaa" || fm.keys()[1] != "bbb" ||
+            fm.values()[0].x != 1 || fm.values()[1].x != 2)
+        {
+            cerr << "flat_map在排序时抛出异常后状态不一致\n";
+            return 1;
+        }
+    }
+
+    // 键0..n-1打乱顺序；值是"value"加键（不超过15个字符，在string内部存储，不额外分配内存）
+    vector<pair<int, string>> input;
+    input.reserve(static_cast<size_t>(n));
+    for (int k = 0; k < n; ++k)
+    {
+        input.emplace_back(k, "value" + to_string(k));
+    }
+    mt19937 rng(42);
+    shuffle(input.begin(), input.end(), rng);
+    vector<int> queries(input.size());
+    for (size_t i = 0; i < queries.size(); ++i)
+    {
+        queries[i] = static_cast<int>(rng() % static_cast<unsigned>(n));
+    }
+
+    map<int, string> mp;
+    flat_map<int, string> fm;
+    cout << n << " 个元素                          std::map       flat_map    加速比\n";
+    report("构建", best_ms(1, [&] { mp.insert(input.begin(), input.end()); }),
+           best_ms(1, [&] { fm.insert(input.begin(), input.end()); }));
+
+    bool ok = true;
+    auto compare = [&](const char *name, auto on_map, auto on_flat) {
+        size_t a = 0, b = 0;
+        double map_ms = best_ms(5, [&] { a = on_map(); });
+        double flat_ms = best_ms(5, [&] { b = on_flat(); });
+        report(name, map_ms, flat_ms);
+        if (a != b)
+        {
+            cerr << name << "：结果不一致（" << a << " / " << b << "）\n";
+            ok = false;
+        }
+    };
+    compare("reverse | filter | values", [&] { return reverse_filter_values(mp); },
+            [&] { return reverse_filter_values(fm); });
+    compare("transform | filter", [&] { return transform_filter(mp); }, [&] { return transform_filter(fm); });
+    compare("filter | reverse | values", [&] { return filter_reverse_values(mp); },
+            [&] { return filter_reverse_values(fm); });
+    compare("values", [&] { return all_values(mp | views::values); },
+            [&] { return all_values(fm | views::values); });
+    compare("values（flat_map::values()数组）", [&] { return all_values(mp | views::values); },
+            [&] { return all_values(fm.values()); });
+    compare("find（随机键）", [&] { return find_all(mp, queries); }, [&] { return find_all(fm, queries); });
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+// To compile: g++ -std=c++20 -O2 mapped_file_reader_benchmark.cpp -o mapped_bench
+// To run:     ./mapped_bench [文件大小(MB)] [文件路径]
+
+// 程序功能：对比两种逐行扫描日志文件的方式
+// 1. std::ifstream + std::getline：每行都要把数据从内核缓冲区拷贝到std::string
+// 2. mapped_file + lines()：内存映射后直接得到指向映射区的std::string_view，零拷贝
+// 两种方式统计相同的指标（总行数、含"ERROR"的行数、总字节数），结果必须一致
+#include <algorithm> // 提供std::ranges::for_each
+#include <chrono>    // 提供计时功能
+#include <cstdio>    // 提供std::remove
+#include <cstdlib>   // 提供std::atoi
+#include <fstream>   // 提供std::ifstream/ofstream
+#include <iostream>
+#include <string>
+#include <string_view>
+#include "../code/08 - iterators/mapped_file_reader.hpp"
+
+using namespace std;
+
+/**
+ * @brief 生成测试用的日志文件
+ * @param path 文件路径
+ * @param megabytes 文件大小（MB）
+ */
+void make_log(const string &path, size_t megabytes)
+{
+    ofstream ofs(path, ios::binary);
+    string line;
+    size_t written = 0;
+    for (size_t i = 0; written < megabytes << 20; ++i)
+    {
+        line = "2024-01-01T00:00:00 ";
+        line += (i % 17 == 0) ? "ERROR" : "INFO";
+        line += " request id=" + to_string(i) + " took " +
+                to_string(i % 1000) + "us\n";
+        ofs << line;
+        written += line.size();
+    }
+}
+
+struct scan_result
+{
+    size_t lines = 0;  // 总行数
+    size_t errors = 0; // 含"ERROR"的行数
+    size_t bytes = 0;  // 不含换行符的总字节数
+};
+
+/**
+ * @brief 测量回调耗时（毫秒）
+ */
+template <typename F>
+double time_ms(F fn)
+{
+    auto start = chrono::steady_clock::now();
+    fn();
+    auto stop = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(stop - start).count();
+}
+
+int main(int argc, char *argv[])
+{
+    size_t megabytes = argc > 1 ? atoi(argv[1]) : 2048;
+    string path = argc > 2 ? argv[2] : "mapped_bench.log";
+    make_log(path, megabytes);
+
+    // 方式1：ifstream + getline
+    scan_result by_getline;
+    double getline_ms = time_ms([&] {
+        ifstream ifs(path, ios::binary);
+        string line;
+        while (getline(ifs, line))
+        {
+            ++by_getline.lines;
+            by_getline.bytes += line.size();
+            if (line.find("ERROR") != string::npos)
+                ++by_getline.errors;
+        }
+    });
+
+    // 方式2：mapped_file + lines()，直接使用std::ranges算法
+    scan_result by_mmap;
+    double mmap_ms = time_ms([&] {
+        mapped_file file(path);
+        auto view = lines(file);
+        std::ranges::for_each(view, [&](string_view line) {
+            ++by_mmap.lines;
+            by_mmap.bytes += line.size();
+            if (line.find("ERROR") != string_view::npos)
+                ++by_mmap.errors;
+        });
+    });
+
+    // 方式3：mapped_c_string_reader逐字节遍历（与c_string_reader相同的用法）
+    size_t newlines = 0;
+    double bytes_ms = time_ms([&] {
+        mapped_file file(path);
+        mapped_c_string_reader reader(file);
+        std::ranges::for_each(reader.begin(), reader.end(),
+                              [&](char ch) { newlines += ch == '\n'; });
+    });
+
+    double mb = megabytes;
+    cout << "文件大小：" << megabytes << " MB\n"
+         << "ifstream + getline : " << getline_ms << " ms, "
+         << mb / getline_ms * 1000 << " MB/s\n"
+         << "mapped_file + lines: " << mmap_ms << " ms, "
+         << mb / mmap_ms * 1000 << " MB/s\n"
+         << "逐字节哨兵遍历     : " << bytes_ms << " ms, "
+         << mb / bytes_ms * 1000 << " MB/s\n";
+
+    bool same = by_getline.lines == by_mmap.lines &&
+                by_getline.errors == by_mmap.errors &&
+                by_getline.bytes == by_mmap.bytes && newlines == by_mmap.lines;
+    cout << "行数 " << by_mmap.lines << "，ERROR行 " << by_mmap.errors
+         << "，结果" << (same ? "一致" : "不一致") << '\n';
+
+    std::remove(path.c_str());
+    return same ? 0 : 1;
+}
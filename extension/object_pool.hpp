@@ -0,0 +1,433 @@
+// 定长小对象池头文件：为TestObj这类频繁创建/销毁的小对象提供快速分配
+// 核心特性：
+//   1. 按类型划分的全局对象池（object_pool<T>），槽位大小固定，空闲槽位组成单向空闲链表
+//   2. 内存以按缓存行（64字节）对齐的大块（slab）向系统申请，避免逐个对象调用malloc
+//   3. 每个线程有自己的缓存（thread_local），大多数分配/释放无需加锁，按批次与全局池交换槽位
+//   4. allocate_n/destroy_n批量接口：与new T[n]不同，不在数组前存放“元素个数”cookie，
+//      个数由调用者在destroy_n时给出；释放的连续区段按长度缓存，供同样长度的allocate_n复用
+//   5. 调试模式下（未定义NDEBUG，或定义了OBJECT_POOL_DEBUG）记录每次分配的形式，
+//      发现“单个/数组”不匹配、重复释放时立即报错并终止（对应delete_vs_delete_array_demo.cpp中的错误用法）
+#ifndef OBJECT_POOL_HPP
+#define OBJECT_POOL_HPP
+
+#include <cstddef>       // 提供size_t/max_align_t
+#include <cstdio>        // 提供fprintf（调试模式报错）
+#include <cstdlib>       // 提供abort
+#include <mutex>         // 提供std::mutex/lock_guard
+#include <new>           // 提供operator new(size_t, align_val_t)/placement new
+#include <unordered_map> // 提供调试模式的分配记录表
+#include <utility>       // 提供std::forward
+#include <vector>        // 提供std::vector（记录已申请的slab）
+
+#if !defined(NDEBUG) && !defined(OBJECT_POOL_DEBUG)
+#define OBJECT_POOL_DEBUG 1
+#endif
+
+/**
+ * @brief 按类型划分的定长对象池
+ * @tparam T 对象类型
+ * @tparam SlabBytes 每个slab的字节数
+ */
+template <typename T, size_t SlabBytes = 64 * 1024>
+class object_pool
+{
+public:
+    static constexpr size_t cache_line = 64; // slab的对齐要求（缓存行大小）
+
+    /**
+     * @brief 创建单个对象（对应new T(args...)）
+     */
+    template <typename... Args>
+    static T *create(Args &&...args)
+    {
+        void *mem = local().pop();
+        T *obj;
+        try
+        {
+            obj = ::new (mem) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            local().push(static_cast<slot *>(mem));
+            throw;
+        }
+        debug_record(obj, 0);
+        return obj;
+    }
+
+    /**
+     * @brief 销毁单个对象（对应delete p）
+     */
+    static void destroy(T *p) noexcept
+    {
+        if (p == nullptr)
+        {
+            return;
+        }
+        debug_check(p, 0, "destroy");
+        p->~T();
+        local().push(reinterpret_cast<slot *>(p));
+    }
+
+    /**
+     * @brief 创建n个连续存放的对象（对应new T[n]，但不存放元素个数）
+     * @return 指向第一个对象的指针；n为0时返回nullptr
+     */
+    static T *allocate_n(size_t n)
+    {
+        if (n == 0)
+        {
+            return nullptr;
+        }
+        T *first = reinterpret_cast<T *>(
+            n <= max_run ? local().pop_run(n) : central().take_run(n));
+        size_t i = 0;
+        try
+        {
+            for (; i < n; ++i)
+            {
+                ::new (static_cast<void *>(first + i)) T();
+            }
+        }
+        catch (...)
+        {
+            while (i != 0)
+            {
+                first[--i].~T();
+            }
+            release_run(first, n);
+            throw;
+        }
+        debug_record(first, n);
+        return first;
+    }
+
+    /**
+     * @brief 销毁allocate_n创建的n个对象（对应delete[] p，元素个数由调用者给出）
+     * 与delete[]一致，按与构造相反的顺序析构
+     */
+    static void destroy_n(T *p, size_t n) noexcept
+    {
+        if (p == nullptr)
+        {
+            return;
+        }
+        debug_check(p, n, "destroy_n");
+        for (size_t i = n; i != 0; --i)
+        {
+            p[i - 1].~T();
+        }
+        release_run(p, n);
+    }
+
+private:
+    // 槽位：空闲时存放链表指针，使用时存放对象
+    union slot
+    {
+        slot *next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    static constexpr size_t slot_size = sizeof(slot);
+    static constexpr size_t slots_per_slab = SlabBytes / slot_size;
+    static constexpr size_t batch = 32;    // 线程缓存与全局池每次交换的槽位数
+    static constexpr size_t max_run = 64;  // 按长度缓存的连续区段的最大长度
+    static constexpr size_t run_batch = 8; // 线程缓存与全局池每次交换的区段数
+    static_assert(slots_per_slab >= batch, "slab is too small for the object type");
+    static_assert(alignof(slot) <= cache_line, "over-aligned types are not supported");
+
+    // 全局池：空闲链表 + 当前slab中尚未切分的区域，由互斥量保护
+    class central_pool
+    {
+    public:
+        ~central_pool()
+        {
+            for (void *slab : slabs_)
+            {
+                ::operator delete(slab, std::align_val_t(cache_line));
+            }
+        }
+
+        // 取出最多count个槽位，串成链表返回
+        slot *take(size_t count)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            slot *head = nullptr;
+            for (; count != 0; --count)
+            {
+                slot *s = free_list_;
+                if (s != nullptr)
+                {
+                    free_list_ = s->next;
+                }
+                else
+                {
+                    if (bump_ == bump_end_)
+                    {
+                        new_slab();
+                    }
+                    s = bump_++;
+                }
+                s->next = head;
+                head = s;
+            }
+            return head;
+        }
+
+        // 归还一条槽位链表（tail为链表最后一个节点）
+        void give(slot *head, slot *tail)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tail->next = free_list_;
+            free_list_ = head;
+        }
+
+        // 取出n个连续槽位：优先复用同样长度的已释放区段，其次从当前slab的
+        // 未切分区域切出，不够时申请新slab；超过一个slab容量的请求直接向系统申请
+        slot *take_run(size_t n)
+        {
+            if (n > slots_per_slab)
+            {
+                return static_cast<slot *>(::operator new(
+                    n * slot_size, std::align_val_t(cache_line)));
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (n <= max_run && runs_[n] != nullptr)
+            {
+                slot *run = runs_[n];
+                runs_[n] = run->next;
+                return run;
+            }
+            if (static_cast<size_t>(bump_end_ - bump_) < n)
+            {
+                // 旧slab剩余的零头挂到空闲链表上，不浪费
+                for (; bump_ != bump_end_; ++bump_)
+                {
+                    bump_->next = free_list_;
+                    free_list_ = bump_;
+                }
+                new_slab();
+            }
+            slot *run = bump_;
+            bump_ += n;
+            return run;
+        }
+
+        // 归还一条长度均为n的区段链表（每个区段的首槽位指向下一个区段）
+        void give_runs(size_t n, slot *head, slot *tail)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tail->next = runs_[n];
+            runs_[n] = head;
+        }
+
+    private:
+        void new_slab()
+        {
+            void *mem = ::operator new(slots_per_slab * slot_size,
+                                       std::align_val_t(cache_line));
+            slabs_.push_back(mem);
+            bump_ = static_cast<slot *>(mem);
+            bump_end_ = bump_ + slots_per_slab;
+        }
+
+        std::mutex mutex_;
+        slot *free_list_ = nullptr;
+        slot *bump_ = nullptr;     // 当前slab中未切分区域的起点
+        slot *bump_end_ = nullptr; // 当前slab的尾后位置
+        slot *runs_[max_run + 1] = {}; // runs_[n]：长度为n的空闲区段链表
+        std::vector<void *> slabs_;
+    };
+
+    // 线程缓存：无锁的本地空闲链表，数量过多或过少时与全局池成批交换
+    class local_cache
+    {
+    public:
+        ~local_cache()
+        {
+            flush(count_);
+            for (size_t n = 1; n <= max_run; ++n)
+            {
+                flush_runs(n, run_count_[n]);
+            }
+        }
+
+        void *pop()
+        {
+            if (head_ == nullptr)
+            {
+                head_ = central().take(batch);
+                count_ = batch;
+            }
+            slot *s = head_;
+            head_ = s->next;
+            --count_;
+            return s;
+        }
+
+        void push(slot *s)
+        {
+            s->next = head_;
+            head_ = s;
+            if (++count_ >= 2 * batch)
+            {
+                flush(batch);
+            }
+        }
+
+        // 取出长度为n的连续区段（n <= max_run）
+        slot *pop_run(size_t n)
+        {
+            slot *run = runs_[n];
+            if (run == nullptr)
+            {
+                return central().take_run(n);
+            }
+            runs_[n] = run->next;
+            --run_count_[n];
+            return run;
+        }
+
+        // 缓存长度为n的连续区段（n <= max_run）
+        void push_run(slot *run, size_t n)
+        {
+            run->next = runs_[n];
+            runs_[n] = run;
+            if (++run_count_[n] >= 2 * run_batch)
+            {
+                flush_runs(n, run_batch);
+            }
+        }
+
+    private:
+        // 把长度为n的区段链表中前count个归还全局池
+        void flush_runs(size_t n, size_t count)
+        {
+            if (count == 0)
+            {
+                return;
+            }
+            slot *first = runs_[n];
+            slot *last = first;
+            for (size_t i = 1; i < count; ++i)
+            {
+                last = last->next;
+            }
+            runs_[n] = last->next;
+            run_count_[n] -= count;
+            central().give_runs(n, first, last);
+        }
+
+        // 把链表前count个槽位归还全局池
+        void flush(size_t count)
+        {
+            if (count == 0)
+            {
+                return;
+            }
+            slot *first = head_;
+            slot *last = head_;
+            for (size_t i = 1; i < count; ++i)
+            {
+                last = last->next;
+            }
+            head_ = last->next;
+            count_ -= count;
+            central().give(first, last);
+        }
+
+        slot *head_ = nullptr;
+        size_t count_ = 0;
+        slot *runs_[max_run + 1] = {};      // runs_[n]：长度为n的空闲区段链表
+        size_t run_count_[max_run + 1] = {}; // 各链表中的区段数
+    };
+
+    static central_pool &central()
+    {
+        static central_pool pool;
+        return pool;
+    }
+
+    static local_cache &local()
+    {
+        thread_local local_cache cache;
+        return cache;
+    }
+
+    // 归还allocate_n取得的n个槽位：大块直接还给系统；较短的区段整体缓存，
+    // 供下一次同样长度的allocate_n复用；其余拆成单个槽位放入线程缓存
+    static void release_run(T *p, size_t n) noexcept
+    {
+        if (n > slots_per_slab)
+        {
+            ::operator delete(static_cast<void *>(p), std::align_val_t(cache_line));
+            return;
+        }
+        slot *s = reinterpret_cast<slot *>(p);
+        if (n <= max_run)
+        {
+            local().push_run(s, n);
+            return;
+        }
+        for (size_t i = 0; i < n; ++i)
+        {
+            local().push(s + i);
+        }
+    }
+
+#ifdef OBJECT_POOL_DEBUG
+    // 调试记录：指针 -> 分配形式（0表示单个对象，n表示n个对象的数组）
+    struct debug_registry
+    {
+        std::mutex mutex;
+        std::unordered_map<const void *, size_t> live;
+    };
+
+    static debug_registry &registry()
+    {
+        static debug_registry reg;
+        return reg;
+    }
+
+    static void debug_record(const T *p, size_t n)
+    {
+        std::lock_guard<std::mutex> lock(registry().mutex);
+        registry().live[p] = n;
+    }
+
+    static void debug_check(const T *p, size_t n, const char *op)
+    {
+        std::lock_guard<std::mutex> lock(registry().mutex);
+        auto &live = registry().live;
+        auto it = live.find(p);
+        if (it == live.end())
+        {
+            fprintf(stderr, "object_pool: %s(%p): pointer was not allocated "
+                            "or is already freed\n", op, static_cast<const void *>(p));
+            abort();
+        }
+        if (it->second != n)
+        {
+            if (it->second == 0)
+                fprintf(stderr, "object_pool: %s(%p, %zu): object was created "
+                                "by create(), use destroy()\n", op,
+                        static_cast<const void *>(p), n);
+            else if (n == 0)
+                fprintf(stderr, "object_pool: %s(%p): array of %zu objects was "
+                                "created by allocate_n(), use destroy_n()\n", op,
+                        static_cast<const void *>(p), it->second);
+            else
+                fprintf(stderr, "object_pool: %s(%p, %zu): array has %zu "
+                                "objects\n", op, static_cast<const void *>(p), n,
+                        it->second);
+            abort();
+        }
+        live.erase(it);
+    }
+#else
+    static void debug_record(const T *, size_t) {}
+    static void debug_check(const T *, size_t, const char *) {}
+#endif
+};
+
+#endif // OBJECT_POOL_HPP
@@ -0,0 +1,129 @@
+// To compile: g++ -std=c++17 -O2 -DNDEBUG -pthread object_pool_benchmark.cpp -o pool_bench
+// To run:     ./pool_bench [线程数]
+//             调试模式下演示“单个/数组”不匹配检测：
+//             g++ -std=c++17 -pthread object_pool_benchmark.cpp -o pool_debug && ./pool_debug --mismatch
+
+// 程序功能：对比小对象的三种分配方式在单线程和多线程下的耗时
+// 1. new/delete              vs object_pool::create/destroy
+// 2. new[]/delete[]（有cookie） vs object_pool::allocate_n/destroy_n（无cookie）
+#include <chrono>   // 提供计时功能
+#include <cstdlib>  // 提供std::atoi
+#include <cstring>  // 提供strcmp
+#include <iostream>
+#include <thread>   // 提供std::thread
+#include <vector>
+#include "object_pool.hpp"
+
+using namespace std;
+
+// 与delete_vs_delete_array_demo.cpp中的TestObj对应的小对象
+// 为避免输出开销掩盖分配开销，构造/析构不打印，只维护一个计数
+class TestObj
+{
+public:
+    TestObj() : id_(++live_) {}
+    ~TestObj() { --live_; }
+    static thread_local long live_; // 当前线程存活的对象数
+
+private:
+    long id_;
+    double payload_[2] = {};
+};
+thread_local long TestObj::live_ = 0;
+
+constexpr int rounds = 2000; // 每个线程的轮数
+constexpr int per_round = 512; // 每轮同时存活的对象数
+constexpr int array_len = 8;   // 批量分配时每个数组的元素数
+
+// 场景1：new/delete
+void run_new_delete()
+{
+    vector<TestObj *> objs(per_round);
+    for (int r = 0; r < rounds; ++r)
+    {
+        for (auto &p : objs)
+            p = new TestObj;
+        for (auto p : objs)
+            delete p;
+    }
+}
+
+// 场景2：object_pool::create/destroy
+void run_pool_single()
+{
+    vector<TestObj *> objs(per_round);
+    for (int r = 0; r < rounds; ++r)
+    {
+        for (auto &p : objs)
+            p = object_pool<TestObj>::create();
+        for (auto p : objs)
+            object_pool<TestObj>::destroy(p);
+    }
+}
+
+// 场景3：new[]/delete[]
+void run_new_array()
+{
+    vector<TestObj *> arrays(per_round / array_len);
+    for (int r = 0; r < rounds; ++r)
+    {
+        for (auto &p : arrays)
+            p = new TestObj[array_len];
+        for (auto p : arrays)
+            delete[] p;
+    }
+}
+
+// 场景4：object_pool::allocate_n/destroy_n
+void run_pool_array()
+{
+    vector<TestObj *> arrays(per_round / array_len);
+    for (int r = 0; r < rounds; ++r)
+    {
+        for (auto &p : arrays)
+            p = object_pool<TestObj>::allocate_n(array_len);
+        for (auto p : arrays)
+            object_pool<TestObj>::destroy_n(p, array_len);
+    }
+}
+
+/**
+ * @brief 用threads个线程同时运行fn，返回每个对象的平均分配+释放耗时（纳秒）
+ */
+double measure(void (*fn)(), int threads)
+{
+    auto start = chrono::steady_clock::now();
+    vector<thread> workers;
+    for (int i = 0; i < threads; ++i)
+        workers.emplace_back(fn);
+    for (auto &t : workers)
+        t.join();
+    auto stop = chrono::steady_clock::now();
+    double ns = chrono::duration<double, nano>(stop - start).count();
+    return ns / (double(rounds) * per_round * threads);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1 && strcmp(argv[1], "--mismatch") == 0)
+    {
+        // 对应delete_vs_delete_array_demo.cpp的场景3：数组用单个对象的方式释放
+        TestObj *arr = object_pool<TestObj>::allocate_n(3);
+        cout << "allocate_n(3) 之后调用 destroy(arr)：\n";
+        object_pool<TestObj>::destroy(arr); // 调试模式下报错并终止
+        cout << "未检测到不匹配（以NDEBUG编译时不做检查）\n";
+        return 0;
+    }
+
+    int max_threads = argc > 1 ? atoi(argv[1]) : 8;
+    cout << "每个对象的平均分配+释放耗时（ns）\n"
+         << "线程数\tnew/delete\tcreate/destroy\tnew[]/delete[]\tallocate_n/destroy_n\n";
+    for (int threads = 1; threads <= max_threads; threads *= 2)
+    {
+        cout << threads << '\t' << measure(run_new_delete, threads) << "\t\t"
+             << measure(run_pool_single, threads) << "\t\t"
+             << measure(run_new_array, threads) << "\t\t"
+             << measure(run_pool_array, threads) << '\n';
+    }
+    return 0;
+}
@@ -0,0 +1,128 @@
+// To compile: g++ -std=c++17 -O2 -pthread ostream_range_parallel_benchmark.cpp -o parallel_bench
+// To run:     ./parallel_bench [元素个数]
+
+// 程序功能：
+// 1. 等价性检查：ostream_range::parallel 在不同线程数、块大小和流格式下，
+//    输出必须与串行 operator<< 逐字节一致
+// 2. 扩展性测试：对百万级元素的随机访问范围，测量 1/2/4/8 线程的耗时
+#include <chrono>    // 提供计时功能
+#include <cstdlib>   // 提供std::atoi/EXIT_FAILURE
+#include <iomanip>   // 提供std::setprecision/hex等流操纵符
+#include <iostream>
+#include <sstream>   // 提供std::ostringstream
+#include <string>
+#include <thread>    // 提供std::thread::hardware_concurrency
+#include <utility>
+#include <vector>
+#include "../code/common/ostream_range.h"
+#include "../code/common/ostream_range_parallel.h"
+
+using namespace std;
+
+/**
+ * @brief 校验并行输出与串行输出一致
+ * @param name 用例名称
+ * @param obj 待输出的范围
+ * @param setup 设置流格式的回调（两条流使用相同的设置）
+ * @return bool 所有线程数/块大小组合都一致时返回true
+ */
+template <typename T, typename Setup>
+bool check_equivalence(const char *name, const T &obj, Setup setup)
+{
+    ostringstream serial;
+    setup(serial);
+    serial << obj;
+    for (unsigned threads : {2U, 3U, 8U})
+    {
+        for (size_t chunk : {size_t(1), size_t(7), size_t(1000)})
+        {
+            ostringstream par;
+            setup(par);
+            par << ostream_range::parallel(obj, threads, chunk);
+            if (par.str() != serial.str())
+            {
+                cout << "[不一致] " << name << "：threads=" << threads
+                     << " chunk=" << chunk << '\n';
+                return false;
+            }
+        }
+    }
+    cout << "[一致] " << name << '\n';
+    return true;
+}
+
+/**
+ * @brief 测量输出耗时（毫秒）
+ * @param output 执行一次输出的回调，参数为目标流
+ */
+template <typename F>
+double time_ms(F output)
+{
+    ostringstream os;
+    auto start = chrono::steady_clock::now();
+    output(os);
+    auto stop = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(stop - start).count();
+}
+
+int main(int argc, char *argv[])
+{
+    size_t n = argc > 1 ? atoi(argv[1]) : 2000000;
+
+    vector<pair<int, double>> records;
+    vector<string> names;
+    records.reserve(n);
+    names.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        records.emplace_back(int(i), i * 0.001);
+        names.push_back("snapshot-" + to_string(i));
+    }
+
+    // 等价性检查：用较小的前缀覆盖多种块边界，再覆盖非默认流格式
+    vector<pair<int, double>> small(records.begin(),
+                                    records.begin() + min<size_t>(n, 5000));
+    vector<string> small_names(names.begin(),
+                               names.begin() + min<size_t>(n, 5000));
+    bool ok = check_equivalence("vector<pair<int, double>>", small,
+                                [](ostream &) {}) &&
+              check_equivalence("vector<string>", small_names,
+                                [](ostream &) {}) &&
+              check_equivalence("precision(3) + fixed", small,
+                                [](ostream &os) { os << fixed << setprecision(3); }) &&
+              check_equivalence("hex + showbase", small,
+                                [](ostream &os) { os << hex << showbase; }) &&
+              check_equivalence("setw(12)", small,
+                                [](ostream &os) { os << setw(12); }) &&
+              check_equivalence("空范围", vector<int>{}, [](ostream &) {});
+    if (!ok)
+    {
+        return EXIT_FAILURE;
+    }
+
+    // 扩展性测试
+    cout << "\n硬件并发数：" << thread::hardware_concurrency() << '\n';
+    double serial = time_ms([&](ostream &os) { os << records; });
+    cout << "vector<pair<int, double>> x " << n << "\n  串行: " << serial
+         << " ms\n";
+    for (unsigned threads : {1U, 2U, 4U, 8U})
+    {
+        double t = time_ms([&](ostream &os) {
+            os << ostream_range::parallel(records, threads);
+        });
+        cout << "  " << threads << " 线程: " << t << " ms，加速比 "
+             << serial / t << '\n';
+    }
+
+    serial = time_ms([&](ostream &os) { os << names; });
+    cout << "vector<string> x " << n << "\n  串行: " << serial << " ms\n";
+    for (unsigned threads : {1U, 2U, 4U, 8U})
+    {
+        double t = time_ms([&](ostream &os) {
+            os << ostream_range::parallel(names, threads);
+        });
+        cout << "  " << threads << " 线程: " << t << " ms，加速比 "
+             << serial / t << '\n';
+    }
+    return 0;
+}
@@ -0,0 +1,103 @@
+// To compile: g++ -std=c++17 -O2 ostream_range_plan_benchmark.cpp -o plan_bench
+// To run:     ./plan_bench [元素个数]
+
+// 程序功能：对比 ostream_range 的普通 operator<< 与“编译期格式计划”
+//           （ostream_range::planned）在深层嵌套容器上的输出耗时，
+//           并先校验两者输出逐字节一致。
+#include <chrono>    // 提供计时功能
+#include <cstdlib>   // 提供std::atoi/EXIT_FAILURE
+#include <iostream>
+#include <map>
+#include <sstream>   // 提供std::ostringstream作为输出目标
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "../code/common/ostream_range.h"
+#include "../code/common/ostream_range_plan.h"
+
+using namespace std;
+
+/**
+ * @brief 分别用普通输出和计划输出格式化同一个对象，校验一致后打印耗时
+ * @param name 测试用例名称
+ * @param obj 待输出的容器
+ * @param rounds 重复次数（取总耗时）
+ * @return bool 两种方式输出一致时返回true
+ */
+template <typename T>
+bool run_case(const char *name, const T &obj, int rounds)
+{
+    ostringstream plain_os;
+    ostringstream planned_os;
+    plain_os << obj;
+    planned_os << ostream_range::planned(obj);
+    if (plain_os.str() != planned_os.str())
+    {
+        cout << name << ": 输出不一致！\n";
+        return false;
+    }
+
+    auto time_ms = [rounds](auto &&output) {
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < rounds; ++i)
+        {
+            ostringstream os;
+            output(os);
+        }
+        auto stop = chrono::steady_clock::now();
+        return chrono::duration<double, milli>(stop - start).count();
+    };
+    double plain = time_ms([&obj](ostream &os) { os << obj; });
+    double planned = time_ms(
+        [&obj](ostream &os) { os << ostream_range::planned(obj); });
+
+    double mb = plain_os.str().size() * rounds / 1e6;
+    cout << name << "（输出 " << plain_os.str().size() << " 字节）\n"
+         << "  operator<<: " << plain << " ms, " << mb / plain * 1000
+         << " MB/s\n"
+         << "  planned   : " << planned << " ms, " << mb / planned * 1000
+         << " MB/s，加速比 " << plain / planned << "\n";
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 20000; // 外层元素个数
+    const int rounds = 5;
+
+    // 用例1：请求中的典型类型 map<int, vector<pair<string, double>>>
+    map<int, vector<pair<string, double>>> mp;
+    for (int i = 0; i < n; ++i)
+    {
+        auto &vec = mp[i];
+        for (int j = 0; j < 4; ++j)
+        {
+            vec.emplace_back("item" + to_string(j), i * 0.25 + j);
+        }
+    }
+
+    // 用例2：三层嵌套的整数向量
+    vector<vector<vector<int>>> cube(n / 10 + 1,
+                                     vector<vector<int>>(10, vector<int>(8)));
+    int counter = 0;
+    for (auto &plane : cube)
+        for (auto &row : plane)
+            for (auto &x : row)
+                x = counter++;
+
+    // 用例3：元组中再嵌套容器和字符
+    vector<tuple<int, string, vector<char>, pair<bool, float>>> tuples;
+    for (int i = 0; i < n; ++i)
+    {
+        tuples.emplace_back(i, "name" + to_string(i),
+                            vector<char>{'a', 'b', 'c'},
+                            make_pair(i % 2 == 0, i / 3.0f));
+    }
+
+    bool ok = run_case("map<int, vector<pair<string, double>>>", mp, rounds) &&
+              run_case("vector<vector<vector<int>>>", cube, rounds) &&
+              run_case("vector<tuple<int, string, vector<char>, pair>>",
+                       tuples, rounds);
+    return ok ? 0 : EXIT_FAILURE;
+}
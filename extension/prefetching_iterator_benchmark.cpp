@@ -0,0 +1,150 @@
+// To compile: g++ -std=c++20 -O2 prefetching_iterator_benchmark.cpp -o prefetching_iterator_bench
+// To run:     ./prefetching_iterator_bench [节点数]   （默认1000万个节点，约需1.5GB内存）
+
+// 程序功能：测试prefetching_iterator.hpp在节点式容器反向遍历（reverseOutput的rbegin()/rend()循环）中的效果
+//   容器：std::map<uint32_t, uint32_t>（随机顺序插入，按键遍历时节点地址是乱序的）
+//         std::list<uint64_t>（顺序分配节点后list::sort，节点被重新链接为乱序）
+//   工作量：轻（求和）与重（每个元素做一串整数混合运算，模拟解析/校验等处理）
+//   预取距离K：0（不包装，直接用rbegin()/rend()）、1、2、4、8、16、32
+// 所有K的结果必须一致；另外用std::ranges::for_each遍历一次，确认可以与ranges算法一起使用
+#include <algorithm> // 提供std::ranges::for_each
+#include <chrono>    // 提供计时功能
+#include <cstdint>   // 提供uint32_t/uint64_t
+#include <cstdlib>   // 提供std::atol
+#include <iomanip>   // 提供setw/setprecision
+#include <iostream>
+#include <list>
+#include <map>
+#include <random>    // 提供随机数
+#include <vector>
+#include "../code/08 - iterators/prefetching_iterator.hpp"
+
+using namespace std;
+
+inline uint64_t value_of(uint32_t x) { return x; }
+inline uint64_t value_of(const pair<const uint32_t, uint32_t> &kv) { return kv.second; }
+
+// 轻量工作：累加
+struct light_work
+{
+    uint64_t operator()(uint64_t total, uint64_t x) const { return total + x; }
+};
+
+// 较重的工作：若干轮乘法与移位混合（与total无关的部分可以与下一个节点的访问重叠）
+struct heavy_work
+{
+    uint64_t operator()(uint64_t total, uint64_t x) const
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            x = (x ^ (x >> 29)) * 0xBF58476D1CE4E5B9ULL;
+        }
+        return total + x;
+    }
+};
+
+template <typename Range, typename Work>
+uint64_t reverse_scan(const Range &r, Work work)
+{
+    uint64_t total = 0;
+    for (auto it = r.begin(); it != r.end(); ++it)
+    {
+        total = work(total, value_of(*it));
+    }
+    return total;
+}
+
+// K = 0：与reverseOutput方法2完全相同的rbegin()/rend()循环
+template <typename C, typename Work>
+uint64_t plain_reverse_scan(const C &c, Work work)
+{
+    uint64_t total = 0;
+    for (auto it = c.rbegin(); it != c.rend(); ++it)
+    {
+        total = work(total, value_of(*it));
+    }
+    return total;
+}
+
+template <typename C, typename Work>
+int run(const char *name, const C &c, Work work)
+{
+    cout << "  " << name << '\n';
+    const size_t distances[] = {0, 1, 2, 4, 8, 16, 32};
+    uint64_t expected = 0;
+    for (size_t k : distances)
+    {
+        auto start = chrono::steady_clock::now();
+        uint64_t total = k == 0 ? plain_reverse_scan(c, work)
+                                : reverse_scan(prefetch_reversed(c, k), work);
+        auto elapsed = chrono::steady_clock::now() - start;
+        double ns = chrono::duration<double, nano>(elapsed).count() / c.size();
+        cout << "    K = " << setw(2) << k << fixed << setprecision(2) << setw(8) << ns
+             << " ns/节点\n";
+        if (k == 0)
+        {
+            expected = total;
+        }
+        else if (total != expected)
+        {
+            cerr << name << "：K = " << k << " 的结果不一致\n";
+            return 1;
+        }
+    }
+
+    // 与std::ranges算法配合使用
+    uint64_t total = 0;
+    ranges::for_each(prefetch_reversed(c, 8), [&](const auto &x) { total = work(total, value_of(x)); });
+    if (total != expected)
+    {
+        cerr << name << "：ranges::for_each的结果不一致\n";
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    long arg = argc > 1 ? atol(argv[1]) : 10000000;
+    if (arg <= 0)
+    {
+        cerr << "用法: " << argv[0] << " [节点数]\n";
+        return 1;
+    }
+    const uint32_t n = static_cast<uint32_t>(arg);
+
+    mt19937 gen(9);
+    vector<uint32_t> keys(n);
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        keys[i] = i;
+    }
+    shuffle(keys.begin(), keys.end(), gen);
+
+    {
+        map<uint32_t, uint32_t> m;
+        for (uint32_t k : keys)
+        {
+            m.emplace(k, k * 2654435761u);
+        }
+        cout << "std::map，" << n << " 个节点\n";
+        if (run("轻量工作（求和）", m, light_work()) != 0 || run("较重的工作", m, heavy_work()) != 0)
+        {
+            return 1;
+        }
+    }
+    {
+        list<uint64_t> l;
+        for (uint32_t k : keys)
+        {
+            l.push_back(k);
+        }
+        l.sort(); // 只重新链接节点：按值遍历时节点地址是乱序的
+        cout << "std::list，" << n << " 个节点\n";
+        if (run("轻量工作（求和）", l, light_work()) != 0 || run("较重的工作", l, heavy_work()) != 0)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,327 @@
+// 结构体字段描述（reflection-lite）头文件：为Student/Product这类记录提供不含填充字节的比较、哈希和紧凑序列化
+// 背景：memcpy.cpp按sizeof(Student)整体拷贝，memcmp.cpp按sizeof(Product)整体比较，
+//       填充字节（Product::name之后的2个字节）也被拷贝/比较，其内容不确定，导致相等的记录比较结果不等
+// 核心特性：
+//   1. 通过特化record_traits<T>列出T的字段（RECORD_FIELD宏记录成员指针和offsetof偏移）：
+//          template <>
+//          struct record_traits<Product>
+//          {
+//              using fields = record::field_list<RECORD_FIELD(Product, name),
+//                                                RECORD_FIELD(Product, price),
+//                                                RECORD_FIELD(Product, stock)>;
+//          };
+//   2. record::equal/record::hash：逐字段比较/哈希，只看字段本身，不看填充字节
+//      （浮点字段按==比较，0.0与-0.0相等且哈希值相同）
+//   3. record::encode/decode：把字段依次紧密写入缓冲区（不含填充），packed_size<T>个字节一条记录，记录首尾相接
+//   4. record::encode_n/decode_n：批量编解码；编译期把结构体中相邻且中间没有填充的字段合并为一段，
+//      每段只需一次memcpy（段长是编译期常量，memcpy会被展开为几条mov指令）；
+//      没有任何填充、字段列表又按声明顺序排列的结构体（如Student）整批只需一次memcpy
+// 限制：字段必须是可平凡复制的类型，T必须是标准布局（offsetof的要求）；编码使用本机字节序
+#ifndef RECORD_FIELDS_HPP
+#define RECORD_FIELDS_HPP
+
+#include <array>       // 提供std::array（编译期计算的拷贝段）
+#include <cstddef>     // 提供size_t/offsetof
+#include <cstring>     // 提供memcpy
+#include <functional>  // 提供std::hash
+#include <string_view> // 提供std::string_view（字符数组的哈希）
+#include <type_traits> // 提供std::is_trivially_copyable_v等
+#include <utility>     // 提供std::pair/index_sequence
+
+/**
+ * @brief 记录类型的字段描述，由使用者为每个记录类型特化，提供fields类型（record::field_list<...>）
+ */
+template <typename T>
+struct record_traits;
+
+// 描述Class的成员member：成员指针加上它在结构体中的偏移
+#define RECORD_FIELD(Class, member) ::record::field<&Class::member, offsetof(Class, member)>
+
+namespace record
+{
+
+template <auto Member, size_t Offset>
+struct field;
+
+/**
+ * @brief 单个字段：Member是成员指针（如&Product::price），Offset是成员在结构体中的偏移
+ */
+template <typename Class, typename T, T Class::*Member, size_t Offset>
+struct field<Member, Offset>
+{
+    using class_type = Class;
+    using value_type = T;
+    static constexpr size_t offset = Offset;
+    static constexpr size_t size = sizeof(T);
+
+    static_assert(std::is_trivially_copyable_v<T>, "fields must be trivially copyable");
+
+    static const T &get(const Class &obj) { return obj.*Member; }
+    static T &get(Class &obj) { return obj.*Member; }
+};
+
+template <typename... Fields>
+struct field_list
+{
+};
+
+// 一次memcpy的拷贝段：结构体中从offset开始的size个字节，对应编码中从packed开始的位置
+struct copy_run
+{
+    size_t offset;
+    size_t packed;
+    size_t size;
+};
+
+namespace detail
+{
+
+template <typename T>
+struct fields_of;
+
+template <typename... Fields>
+struct fields_of<field_list<Fields...>>
+{
+    static constexpr size_t count = sizeof...(Fields);
+    static constexpr size_t packed_size = (Fields::size + ... + 0);
+
+    // 把相邻且中间没有填充的字段合并为拷贝段
+    static constexpr auto make_runs()
+    {
+        constexpr size_t offsets[] = {Fields::offset..., 0};
+        constexpr size_t sizes[] = {Fields::size..., 0};
+        std::array<copy_run, count> runs{};
+        size_t n = 0;
+        size_t packed = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (n != 0 && runs[n - 1].offset + runs[n - 1].size == offsets[i])
+            {
+                runs[n - 1].size += sizes[i];
+            }
+            else
+            {
+                runs[n++] = copy_run{offsets[i], packed, sizes[i]};
+            }
+            packed += sizes[i];
+        }
+        return std::pair<std::array<copy_run, count>, size_t>(runs, n);
+    }
+
+    static constexpr auto runs_and_count = make_runs();
+};
+
+template <typename T>
+using fields_t = fields_of<typename record_traits<T>::fields>;
+
+// 字段值的比较：数组逐元素比较，其余类型用==
+template <typename V>
+bool value_equal(const V &a, const V &b)
+{
+    if constexpr (std::is_array_v<V>)
+    {
+        for (size_t i = 0; i < std::extent_v<V>; ++i)
+        {
+            if (!value_equal(a[i], b[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    else
+    {
+        return a == b;
+    }
+}
+
+inline size_t hash_combine(size_t seed, size_t h)
+{
+    return seed ^ (h + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
+template <typename V>
+size_t value_hash(const V &v)
+{
+    if constexpr (std::is_array_v<V> && sizeof(std::remove_extent_t<V>) == 1 &&
+                  std::is_integral_v<std::remove_extent_t<V>>)
+    {
+        // 字符数组：整个数组的字节（与value_equal一致，'\0'之后的字节也参与）
+        return std::hash<std::string_view>()(
+            std::string_view(reinterpret_cast<const char *>(v), sizeof v));
+    }
+    else if constexpr (std::is_array_v<V>)
+    {
+        size_t seed = 0;
+        for (const auto &e : v)
+        {
+            seed = hash_combine(seed, value_hash(e));
+        }
+        return seed;
+    }
+    else
+    {
+        return std::hash<V>()(v);
+    }
+}
+
+template <typename T, typename... Fields>
+bool equal_impl(const T &a, const T &b, field_list<Fields...>)
+{
+    return (value_equal(Fields::get(a), Fields::get(b)) && ...);
+}
+
+template <typename T, typename... Fields>
+size_t hash_impl(const T &obj, field_list<Fields...>)
+{
+    size_t seed = 0;
+    ((seed = hash_combine(seed, value_hash(Fields::get(obj)))), ...);
+    return seed;
+}
+
+} // namespace detail
+
+/**
+ * @brief T编码后的字节数（所有字段大小之和，不含填充）
+ */
+template <typename T>
+constexpr size_t packed_size = detail::fields_t<T>::packed_size;
+
+/**
+ * @brief T的拷贝段个数（编码一条记录需要的memcpy次数）
+ */
+template <typename T>
+constexpr size_t run_count = detail::fields_t<T>::runs_and_count.second;
+
+/**
+ * @brief 逐字段比较两条记录，不比较填充字节
+ */
+template <typename T>
+bool equal(const T &a, const T &b)
+{
+    return detail::equal_impl(a, b, typename record_traits<T>::fields());
+}
+
+/**
+ * @brief 逐字段计算哈希值，与equal一致：equal的两条记录哈希值相同
+ */
+template <typename T>
+size_t hash(const T &obj)
+{
+    return detail::hash_impl(obj, typename record_traits<T>::fields());
+}
+
+/**
+ * @brief 可用作unordered_set/unordered_map模板参数的哈希与相等函数对象
+ */
+struct hasher
+{
+    template <typename T>
+    size_t operator()(const T &obj) const { return record::hash(obj); }
+};
+
+struct equal_to
+{
+    template <typename T>
+    bool operator()(const T &a, const T &b) const { return record::equal(a, b); }
+};
+
+namespace detail
+{
+
+// 按拷贝段逐段memcpy：段的偏移和长度都是编译期常量，展开后没有循环
+// to_record为false时从记录（src）拷贝到编码（dst），为true时反过来
+template <typename T, size_t... R>
+void copy_runs(unsigned char *dst, const unsigned char *src, bool to_record,
+               std::index_sequence<R...>)
+{
+    constexpr auto &runs = fields_t<T>::runs_and_count.first;
+    if (to_record)
+    {
+        (memcpy(dst + runs[R].offset, src + runs[R].packed, runs[R].size), ...);
+    }
+    else
+    {
+        (memcpy(dst + runs[R].packed, src + runs[R].offset, runs[R].size), ...);
+    }
+}
+
+// 编码与内存布局完全相同：只有一段，从偏移0开始覆盖整个结构体
+// （只看packed_size == sizeof不够：字段列表的顺序与声明顺序不同时，编码的字段顺序也不同）
+template <typename T>
+constexpr bool is_identity_layout()
+{
+    constexpr auto &runs = fields_t<T>::runs_and_count.first;
+    return run_count<T> == 1 && runs[0].offset == 0 && runs[0].size == sizeof(T);
+}
+
+} // namespace detail
+
+/**
+ * @brief 把一条记录紧密编码到out（packed_size<T>字节），返回写入后的位置
+ */
+template <typename T>
+unsigned char *encode(const T &obj, unsigned char *out)
+{
+    detail::copy_runs<T>(out, reinterpret_cast<const unsigned char *>(&obj), false,
+                         std::make_index_sequence<run_count<T>>());
+    return out + packed_size<T>;
+}
+
+/**
+ * @brief 从in解码一条记录到obj（obj的填充字节保持不变），返回读取后的位置
+ */
+template <typename T>
+const unsigned char *decode(const unsigned char *in, T &obj)
+{
+    detail::copy_runs<T>(reinterpret_cast<unsigned char *>(&obj), in, true,
+                         std::make_index_sequence<run_count<T>>());
+    return in + packed_size<T>;
+}
+
+/**
+ * @brief 批量编码n条记录，记录首尾相接写入out（需要n * packed_size<T>字节），返回写入后的位置
+ */
+template <typename T>
+unsigned char *encode_n(const T *first, size_t n, unsigned char *out)
+{
+    if constexpr (detail::is_identity_layout<T>())
+    {
+        // 编码与内存布局完全相同
+        memcpy(out, first, n * sizeof(T));
+        return out + n * sizeof(T);
+    }
+    else
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            out = encode(first[i], out);
+        }
+        return out;
+    }
+}
+
+/**
+ * @brief 批量解码n条记录到first开始的数组，返回读取后的位置
+ */
+template <typename T>
+const unsigned char *decode_n(const unsigned char *in, size_t n, T *first)
+{
+    if constexpr (detail::is_identity_layout<T>())
+    {
+        memcpy(first, in, n * sizeof(T));
+        return in + n * sizeof(T);
+    }
+    else
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            in = decode(in, first[i]);
+        }
+        return in;
+    }
+}
+
+} // namespace record
+
+#endif // RECORD_FIELDS_HPP
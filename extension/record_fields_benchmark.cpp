@@ -0,0 +1,244 @@
+// To compile: g++ -std=c++17 -O2 record_fields_benchmark.cpp -o record_fields_bench
+// To run:     ./record_fields_bench [记录数]
+
+// 程序功能：用record_fields.hpp描述memcpy.cpp的Student和memcmp.cpp的Product，
+//   1. 检查equal/hash忽略填充字节：字段相同、填充字节不同的两条Product记录相等且哈希值相同
+//   2. 对比批量编码/解码的吞吐量（默认各1000万条记录）
+//      - memcpy整个数组：最快，但Product的填充字节也被写入缓冲区（既浪费空间，又使内容不确定）
+//      - 逐字段memcpy：每个字段一次memcpy
+//      - encode_n/decode_n：相邻字段合并为拷贝段，每段一次memcpy
+//   另外检查字段列表与声明顺序不同时，批量编解码与逐条编解码一致
+//   编码结果与解码后的记录都要校验：两种紧凑编码的字节必须一致，解码后的记录必须与原记录equal
+#include <chrono>        // 提供计时功能
+#include <cstdlib>       // 提供std::atol
+#include <cstring>       // 提供memcpy/memset/memcmp
+#include <iomanip>       // 提供setw/setprecision
+#include <iostream>
+#include <random>        // 提供随机数
+#include <unordered_set> // 提供std::unordered_set（按字段去重）
+#include <vector>
+#include "record_fields.hpp"
+
+using namespace std;
+
+// 与memcpy.cpp相同的结构体（没有填充字节）
+struct Student
+{
+    char name[20]; // 姓名
+    int age;       // 年龄
+    float score;   // 分数
+};
+
+// 与memcmp.cpp相同的结构体（name之后有2个填充字节）
+struct Product
+{
+    char name[10]; // 商品名称
+    float price;   // 价格
+    int stock;     // 库存
+};
+
+template <>
+struct record_traits<Student>
+{
+    using fields = record::field_list<RECORD_FIELD(Student, name),
+                                      RECORD_FIELD(Student, age),
+                                      RECORD_FIELD(Student, score)>;
+};
+
+template <>
+struct record_traits<Product>
+{
+    using fields = record::field_list<RECORD_FIELD(Product, name),
+                                      RECORD_FIELD(Product, price),
+                                      RECORD_FIELD(Product, stock)>;
+};
+
+// 字段列表的顺序与声明顺序不同：没有填充，但编码顺序是b、a，不能整批memcpy
+struct Swapped
+{
+    int a;
+    int b;
+};
+
+template <>
+struct record_traits<Swapped>
+{
+    using fields = record::field_list<RECORD_FIELD(Swapped, b), RECORD_FIELD(Swapped, a)>;
+};
+
+static_assert(record::packed_size<Student> == sizeof(Student), "Student has no padding");
+static_assert(record::packed_size<Product> == 18 && sizeof(Product) == 20, "Product has 2 padding bytes");
+static_assert(record::run_count<Student> == 1 && record::run_count<Product> == 2,
+              "adjacent fields are merged into runs");
+
+// 逐字段编码/解码：对照组，每个字段单独一次memcpy
+template <typename T, typename... Fields>
+unsigned char *encode_each(const T &obj, unsigned char *out, record::field_list<Fields...>)
+{
+    ((memcpy(out, &Fields::get(obj), Fields::size), out += Fields::size), ...);
+    return out;
+}
+
+template <typename T, typename... Fields>
+const unsigned char *decode_each(const unsigned char *in, T &obj, record::field_list<Fields...>)
+{
+    ((memcpy(&Fields::get(obj), in, Fields::size), in += Fields::size), ...);
+    return in;
+}
+
+template <typename Fn>
+void timed(const char *name, size_t bytes, Fn fn)
+{
+    auto start = chrono::steady_clock::now();
+    fn();
+    auto elapsed = chrono::steady_clock::now() - start;
+    double ms = chrono::duration<double, milli>(elapsed).count();
+    cout << "  " << left << setw(24) << name << right << fixed << setprecision(1)
+         << setw(8) << ms << " ms" << setw(10) << bytes / ms / 1e3 << " MB/s\n";
+}
+
+// 字段相同而填充字节不同的记录：equal/hash必须忽略填充字节，memcmp则不能
+bool padding_check()
+{
+    Product a, b;
+    memset(&a, 0x00, sizeof a);
+    memset(&b, 0xFF, sizeof b);
+    for (Product *p : {&a, &b})
+    {
+        memset(p->name, 0, sizeof p->name);
+        strcpy(p->name, "Phone");
+        p->price = 2999.99f;
+        p->stock = 100;
+    }
+    Product c = a;
+    c.price = -0.0f;
+    Product d = b;
+    d.price = 0.0f;
+    unordered_set<Product, record::hasher, record::equal_to> unique{a, b, c, d};
+    return memcmp(&a, &b, sizeof a) != 0 && record::equal(a, b) &&
+           record::hash(a) == record::hash(b) && record::equal(c, d) &&
+           record::hash(c) == record::hash(d) && unique.size() == 2;
+}
+
+// 字段列表乱序时，encode_n/decode_n必须与逐条encode/decode的结果相同
+bool order_check()
+{
+    const Swapped in[3] = {{1, 2}, {3, 4}, {5, 6}};
+    unsigned char each[sizeof in], batch[sizeof in];
+    unsigned char *out = each;
+    for (const Swapped &r : in)
+    {
+        out = record::encode(r, out);
+    }
+    record::encode_n(in, 3, batch);
+    Swapped back[3];
+    record::decode_n(batch, 3, back);
+    int first_encoded;
+    memcpy(&first_encoded, batch, sizeof first_encoded);
+    return memcmp(each, batch, sizeof in) == 0 && first_encoded == 2 && back[2].a == 5 && back[2].b == 6;
+}
+
+/**
+ * @brief 对n条T记录比较三种编码/解码方式，返回0表示校验通过
+ */
+template <typename T>
+int run(const char *type_name, const vector<T> &records)
+{
+    const size_t n = records.size();
+    const size_t packed = n * record::packed_size<T>;
+    cout << type_name << "：sizeof = " << sizeof(T) << "，紧凑编码 " << record::packed_size<T>
+         << " 字节/条，" << record::run_count<T> << " 次memcpy/条\n";
+
+    vector<unsigned char> raw(n * sizeof(T));
+    vector<unsigned char> each(packed), runs(packed);
+    timed("编码：memcpy整个数组", raw.size(), [&] {
+        memcpy(raw.data(), records.data(), raw.size());
+    });
+    timed("编码：逐字段memcpy", packed, [&] {
+        unsigned char *out = each.data();
+        for (const T &r : records)
+        {
+            out = encode_each(r, out, typename record_traits<T>::fields());
+        }
+    });
+    timed("编码：encode_n", packed, [&] {
+        record::encode_n(records.data(), n, runs.data());
+    });
+    if (each != runs)
+    {
+        cerr << type_name << "：两种紧凑编码的结果不一致\n";
+        return 1;
+    }
+
+    vector<T> out(n);
+    timed("解码：memcpy整个数组", raw.size(), [&] {
+        memcpy(out.data(), raw.data(), raw.size());
+    });
+    timed("解码：逐字段memcpy", packed, [&] {
+        const unsigned char *in = each.data();
+        for (T &r : out)
+        {
+            in = decode_each(in, r, typename record_traits<T>::fields());
+        }
+    });
+    timed("解码：decode_n", packed, [&] {
+        record::decode_n(runs.data(), n, out.data());
+    });
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (!record::equal(out[i], records[i]))
+        {
+            cerr << type_name << "：第" << i << "条记录解码结果不一致\n";
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    long count = argc > 1 ? atol(argv[1]) : 10000000;
+    if (count <= 0)
+    {
+        cerr << "用法: " << argv[0] << " [记录数]\n";
+        return 1;
+    }
+    if (!padding_check())
+    {
+        cerr << "equal/hash没有忽略填充字节\n";
+        return 1;
+    }
+    if (!order_check())
+    {
+        cerr << "字段列表乱序时encode_n/decode_n与encode/decode不一致\n";
+        return 1;
+    }
+
+    mt19937 gen(11);
+    uniform_int_distribution<int> letter('a', 'z');
+    uniform_int_distribution<int> number(0, 9999);
+    const size_t n = static_cast<size_t>(count);
+
+    vector<Student> students(n);
+    vector<Product> products(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        Student &s = students[i];
+        Product &p = products[i];
+        memset(&p, 0xCC, sizeof p); // 填充字节是不确定的内容
+        for (size_t k = 0; k < sizeof s.name; ++k)
+        {
+            s.name[k] = k < 8 ? static_cast<char>(letter(gen)) : '\0';
+        }
+        for (size_t k = 0; k < sizeof p.name; ++k)
+        {
+            p.name[k] = k < 5 ? static_cast<char>(letter(gen)) : '\0';
+        }
+        s.age = number(gen) % 80;
+        s.score = number(gen) / 100.0f;
+        p.price = number(gen) / 100.0f;
+        p.stock = number(gen) - 100;
+    }
+
+    return run("Student", students) != 0 || run("Product", products) != 0;
+}
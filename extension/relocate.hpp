@@ -0,0 +1,90 @@
+// 可重叠的批量搬移（relocate）头文件：把一段对象整体搬到另一个位置，源与目标可以重叠
+// 背景：memcpy.cpp示例5说明memcpy处理重叠内存是未定义行为，memmove才是正确的做法；
+//       而vector式的insert/erase对每个元素调用移动构造/移动赋值（没有移动构造函数的String甚至是深拷贝），
+//       对大多数类型来说，这等价于把对象的字节原样挪动一下
+// 核心概念：
+//   “搬移”一个对象 = 在新位置移动构造 + 销毁旧位置的对象，完成后旧位置是未初始化的内存
+//   可平凡搬移（trivially relocatable）的类型：搬移等价于按字节复制，例如所有可平凡复制的类型，
+//   以及不含指向自身的指针的资源管理类（String、std::unique_ptr等）
+// 核心特性：
+//   1. is_trivially_relocatable<T>：默认等于std::is_trivially_copyable<T>，可以为具体类型特化为true
+//   2. relocate_n(first, n, d_first)：搬移n个对象；检测源与目标是否重叠及方向：
+//      - 可平凡搬移的类型：一次memmove（库实现按重叠方向选择向前或向后的SIMD复制）
+//      - 其他类型：逐个移动构造+析构，目标在源之后且重叠时从后往前搬
+//   3. shift_range(first, last, by)：把[first, last)整体平移by个位置（by可为负），是insert/erase的基础：
+//          insert：shift_range(pos, end, 1)后在pos处构造新元素
+//          erase：销毁pos处的元素后shift_range(pos + 1, end, -1)
+// 约定：目标范围中不与源重叠的部分必须是未初始化的内存；搬移后源范围中不与目标重叠的部分变为未初始化
+#ifndef RELOCATE_HPP
+#define RELOCATE_HPP
+
+#include <cstddef>     // 提供size_t/ptrdiff_t
+#include <cstring>     // 提供memmove
+#include <new>         // 提供placement new
+#include <type_traits> // 提供std::is_trivially_copyable等
+#include <utility>     // 提供std::move
+
+/**
+ * @brief T是否可平凡搬移（按字节复制即可完成搬移）；资源管理类可以特化为true
+ */
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T>
+{
+};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+/**
+ * @brief 把[first, first + n)中的对象搬移到d_first开始的位置，源与目标可以重叠
+ * @return 目标范围的末尾d_first + n
+ */
+template <typename T>
+T *relocate_n(T *first, size_t n, T *d_first) noexcept
+{
+    if (n == 0 || first == d_first)
+    {
+        return d_first + n;
+    }
+    if constexpr (is_trivially_relocatable_v<T>)
+    {
+        memmove(static_cast<void *>(d_first), static_cast<const void *>(first), n * sizeof(T));
+    }
+    else
+    {
+        static_assert(std::is_nothrow_move_constructible_v<T>,
+                      "element-wise relocation needs a noexcept move constructor");
+        if (d_first < first || d_first >= first + n)
+        {
+            // 目标在源之前，或不重叠：从前往后搬，每个位置在被覆盖之前都已搬走
+            for (size_t i = 0; i < n; ++i)
+            {
+                ::new (static_cast<void *>(d_first + i)) T(std::move(first[i]));
+                first[i].~T();
+            }
+        }
+        else
+        {
+            // 目标在源之后且重叠：从后往前搬
+            for (size_t i = n; i != 0; --i)
+            {
+                ::new (static_cast<void *>(d_first + i - 1)) T(std::move(first[i - 1]));
+                first[i - 1].~T();
+            }
+        }
+    }
+    return d_first + n;
+}
+
+/**
+ * @brief 把[first, last)中的对象整体平移by个位置（by > 0向后，by < 0向前）
+ * @return 平移后范围的起点first + by
+ */
+template <typename T>
+T *shift_range(T *first, T *last, ptrdiff_t by) noexcept
+{
+    relocate_n(first, static_cast<size_t>(last - first), first + by);
+    return first + by;
+}
+
+#endif // RELOCATE_HPP
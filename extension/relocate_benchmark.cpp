@@ -0,0 +1,203 @@
+// To compile: g++ -std=c++17 -O2 relocate_benchmark.cpp -o relocate_bench
+// To run:     ./relocate_bench [批量平移的元素数] [数组长度] [插入/删除次数]
+
+// 程序功能：测试relocate.hpp的relocate_n/shift_range
+//   场景1：大数组（默认1000万个int）整体向前/向后平移1个位置，与std::copy/std::move_backward对比
+//          （重叠时std::copy只能用于向前、std::move_backward只能用于向后；shift_range自动判断方向）
+//   场景2：vector式的随机位置插入/删除，对比vector<T>::insert/erase（逐元素移动或拷贝）与基于shift_range的数组
+//          元素类型：int、String（string.hpp，只有拷贝构造函数，特化为可平凡搬移）、
+//          std::string（不特化，走逐元素移动的后备路径）
+// 所有结果都与标准库版本逐个比较
+#include <algorithm> // 提供std::copy/std::move_backward/std::equal
+#include <chrono>    // 提供计时功能
+#include <cstdlib>   // 提供std::atol
+#include <iomanip>   // 提供setw/setprecision
+#include <iostream>
+#include <new>       // 提供operator new/placement new
+#include <random>    // 提供随机数
+#include <string>
+#include <vector>
+#include "relocate.hpp"
+#include "../code/01 - c and cpp basics/string.hpp"
+
+using namespace std;
+
+// String只保存指向堆内存的指针，搬移时按字节复制即可（旧位置不再析构）
+template <>
+struct is_trivially_relocatable<String> : std::true_type
+{
+};
+
+/**
+ * @brief 定长容量的数组，insert/erase用shift_range平移元素
+ */
+template <typename T>
+class shifting_array
+{
+public:
+    explicit shifting_array(size_t capacity)
+        : data_(static_cast<T *>(::operator new(capacity * sizeof(T)))), capacity_(capacity)
+    {
+    }
+
+    shifting_array(const shifting_array &) = delete;
+    shifting_array &operator=(const shifting_array &) = delete;
+
+    ~shifting_array()
+    {
+        for (size_t i = 0; i < size_; ++i)
+        {
+            data_[i].~T();
+        }
+        ::operator delete(data_);
+    }
+
+    void insert(size_t pos, const T &value)
+    {
+        T tmp(value); // 先构造好新元素，平移之后不会再失败
+        shift_range(data_ + pos, data_ + size_, 1);
+        relocate_n(&tmp, 1, data_ + pos);
+        ::new (static_cast<void *>(&tmp)) T(); // tmp已被搬走，重新构造一个空对象供析构
+        ++size_;
+    }
+
+    void erase(size_t pos)
+    {
+        data_[pos].~T();
+        shift_range(data_ + pos + 1, data_ + size_, -1);
+        --size_;
+    }
+
+    size_t size() const { return size_; }
+    const T &operator[](size_t i) const { return data_[i]; }
+
+private:
+    T *data_;
+    size_t capacity_;
+    size_t size_ = 0;
+};
+
+template <typename Fn>
+double timed(const char *name, Fn fn)
+{
+    auto start = chrono::steady_clock::now();
+    fn();
+    auto elapsed = chrono::steady_clock::now() - start;
+    double ms = chrono::duration<double, milli>(elapsed).count();
+    cout << "  " << left << setw(32) << name << right << fixed << setprecision(2)
+         << setw(10) << ms << " ms\n";
+    return ms;
+}
+
+bool same_value(int a, int b) { return a == b; }
+bool same_value(const String &a, const String &b) { return a == b; }
+bool same_value(const string &a, const string &b) { return a == b; }
+
+// 场景1：整体平移
+int run_bulk(size_t n)
+{
+    cout << "场景1：" << n << " 个int整体平移1个位置\n";
+    vector<int> a(n + 1), b(n + 1);
+    for (size_t i = 0; i < n; ++i)
+    {
+        a[i + 1] = b[i + 1] = static_cast<int>(i);
+    }
+    // 向前：[1, n + 1) -> [0, n)
+    timed("std::copy（向前）", [&] { copy(a.begin() + 1, a.end(), a.begin()); });
+    timed("shift_range(-1)", [&] { shift_range(b.data() + 1, b.data() + n + 1, -1); });
+    // 向后：[0, n) -> [1, n + 1)
+    timed("std::move_backward（向后）", [&] { move_backward(a.begin(), a.end() - 1, a.end()); });
+    timed("shift_range(+1)", [&] { shift_range(b.data(), b.data() + n, 1); });
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (a[i + 1] != static_cast<int>(i) || b[i + 1] != static_cast<int>(i))
+        {
+            cerr << "整体平移的结果错误\n";
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 场景2：在长度约为size的数组中随机插入/删除ops次
+ * make(i)生成第i个新元素
+ */
+template <typename T, typename Make>
+int run_edits(const char *type_name, size_t size, size_t ops, Make make)
+{
+    cout << "场景2：" << type_name << "，数组长度 " << size << "，插入/删除 " << ops << " 次\n";
+    vector<T> v;
+    v.reserve(size + ops);
+    shifting_array<T> s(size + ops);
+    for (size_t i = 0; i < size; ++i)
+    {
+        v.insert(v.end(), make(i));
+        s.insert(s.size(), make(i));
+    }
+
+    // 两个容器使用同一串随机操作：偶数次插入、奇数次删除
+    mt19937 gen(3);
+    vector<size_t> positions(ops);
+    for (size_t k = 0; k < ops; ++k)
+    {
+        positions[k] = uniform_int_distribution<size_t>(0, size - (k % 2))(gen);
+    }
+
+    double a = timed("vector::insert/erase", [&] {
+        for (size_t k = 0; k < ops; ++k)
+        {
+            if (k % 2 == 0)
+                v.insert(v.begin() + positions[k], make(k));
+            else
+                v.erase(v.begin() + positions[k]);
+        }
+    });
+    double b = timed("shift_range", [&] {
+        for (size_t k = 0; k < ops; ++k)
+        {
+            if (k % 2 == 0)
+                s.insert(positions[k], make(k));
+            else
+                s.erase(positions[k]);
+        }
+    });
+    cout << "  加速比 " << setprecision(1) << a / b << "x\n";
+
+    if (v.size() != s.size())
+    {
+        cerr << type_name << "：元素个数不一致\n";
+        return 1;
+    }
+    for (size_t i = 0; i < v.size(); ++i)
+    {
+        if (!same_value(v[i], s[i]))
+        {
+            cerr << type_name << "：第" << i << "个元素不一致\n";
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    long bulk = argc > 1 ? atol(argv[1]) : 10000000;
+    long size = argc > 2 ? atol(argv[2]) : 4096;
+    long ops = argc > 3 ? atol(argv[3]) : 10000;
+    if (bulk <= 0 || size <= 0 || ops <= 0)
+    {
+        cerr << "用法: " << argv[0] << " [批量平移的元素数] [数组长度] [插入/删除次数]\n";
+        return 1;
+    }
+
+    auto text = [](size_t i) { return "record #" + to_string(i) + " with a long enough payload"; };
+    if (run_bulk(static_cast<size_t>(bulk)) != 0 ||
+        run_edits<int>("int", size, ops, [](size_t i) { return static_cast<int>(i); }) != 0 ||
+        run_edits<String>("String", size, ops, [&](size_t i) { return String(text(i).c_str()); }) != 0 ||
+        run_edits<string>("std::string", size, ops, text) != 0)
+    {
+        return 1;
+    }
+    return 0;
+}
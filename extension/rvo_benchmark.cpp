@@ -0,0 +1,180 @@
+// To compile: for o in 0 1 2 3; do g++ -std=c++17 -O$o -DOPT_LEVEL='"-O'$o'"' rvo_benchmark.cpp -o rvo_bench_O$o; done
+// To run:     for o in 0 1 2 3; do ./rvo_bench_O$o [调用次数]; done
+
+// 程序功能：测量rvo.cpp中五种返回方式的实际开销，为“返回局部对象时不要写std::move”
+//           “尽量只返回同一个具名对象”等编码规范提供数据
+// 返回类型换成了两种“重”对象：
+//   1. Buffer：内含4KiB数组，移动与拷贝一样，都要复制4KiB
+//   2. BigString：包装String（../code/01），内容4KiB；String没有移动构造，转移时重新分配并拷贝
+// 输出每种方式的ns/次调用、每次调用的转移次数（拷贝+移动构造）和转移的字节数；
+// 转移次数由counted（../code/03/counted.hpp）统计，和rvo_counts.cpp检查的是同一组数字
+#include <chrono>   // 提供计时功能
+#include <cstdlib>  // 提供std::atol
+#include <cstring>  // 提供memset
+#include <iomanip>  // 提供setw/setprecision
+#include <iostream>
+#include <utility>  // 提供std::move
+#include "../code/01 - c and cpp basics/string.hpp"
+#include "../code/03 - value categories and move semantics/counted.hpp"
+
+using namespace std;
+
+#ifndef OPT_LEVEL
+#ifdef __OPTIMIZE__
+#define OPT_LEVEL "optimized"
+#else
+#define OPT_LEVEL "-O0"
+#endif
+#endif
+
+#define NOINLINE __attribute__((noinline))
+
+// 运行时才确定的分支条件（从命令行参数个数推出，编译器无法常量折叠）
+bool cond = false;
+
+constexpr size_t payload_size = 4096;
+
+// 4KiB的内联缓冲区：构造时填满，转移时整体复制
+struct Buffer : counted<Buffer>
+{
+    char data[payload_size];
+
+    Buffer(int num = 0) { memset(data, num, sizeof data); }
+
+    char first() const { return data[0]; }
+    static size_t bytes_per_transfer() { return sizeof(data); }
+};
+
+// 4KiB的String：转移时分配新内存并拷贝（String只有拷贝构造）
+struct BigString : counted<BigString>
+{
+    String str;
+
+    BigString(int num = 0) : str(text(num)) {}
+
+    char first() const { return str.c_str()[0]; }
+    static size_t bytes_per_transfer() { return payload_size; }
+
+private:
+    // 返回长度为payload_size - 1、由字符'a' + num组成的C字符串
+    static const char *text(int num)
+    {
+        static char buf[4][payload_size];
+        char *s = buf[num & 3];
+        if (s[0] == 0)
+        {
+            memset(s, 'a' + (num & 3), payload_size - 1);
+            s[payload_size - 1] = 0;
+        }
+        return s;
+    }
+};
+
+// 五种返回方式，与rvo.cpp一一对应；NOINLINE防止编译器把调用整体内联后消掉返回值
+template <typename T>
+NOINLINE T getA_unnamed_rvo()
+{
+    return T();
+}
+
+template <typename T>
+NOINLINE T getA_named_rvo()
+{
+    T a;
+    return a;
+}
+
+template <typename T>
+NOINLINE T getA_named_rvo_suppressed()
+{
+    T a;
+    return std::move(a); // 故意抑制NRVO
+}
+
+template <typename T>
+NOINLINE T getA_no_rvo1()
+{
+    T a(1);
+    if (cond)
+    {
+        return T();
+    }
+    else
+    {
+        return a;
+    }
+}
+
+template <typename T>
+NOINLINE T getA_no_rvo2()
+{
+    T a1(1);
+    T a2(2);
+    if (cond)
+    {
+        return a1;
+    }
+    else
+    {
+        return a2;
+    }
+}
+
+volatile char sink; // 防止返回值被优化掉
+
+/**
+ * @brief 测量一种返回方式：先调用一次统计转移次数，再计时calls次调用
+ */
+template <typename T>
+void measure(const char *pattern, T (*fn)(), long calls)
+{
+    T::reset();
+    {
+        T a = fn();
+        sink = a.first();
+    }
+    object_counts c = T::counts();
+    size_t transfers = c.copy_constructs + c.move_constructs;
+
+    auto start = chrono::steady_clock::now();
+    for (long i = 0; i < calls; ++i)
+    {
+        T a = fn();
+        sink = a.first();
+    }
+    auto elapsed = chrono::steady_clock::now() - start;
+    double ns = chrono::duration<double, nano>(elapsed).count() / calls;
+
+    cout << "  " << left << setw(28) << pattern << right << fixed
+         << setprecision(1) << setw(10) << ns << setw(12) << transfers
+         << setw(14) << transfers * T::bytes_per_transfer() << '\n';
+}
+
+template <typename T>
+void run(const char *type_name, long calls)
+{
+    cout << type_name << "\n  " << left << setw(28) << "pattern" << right
+         << setw(10) << "ns/call" << setw(12) << "transfers" << setw(14)
+         << "bytes moved" << '\n';
+    measure<T>("getA_unnamed_rvo", getA_unnamed_rvo<T>, calls);
+    measure<T>("getA_named_rvo", getA_named_rvo<T>, calls);
+    measure<T>("getA_named_rvo_suppressed", getA_named_rvo_suppressed<T>, calls);
+    measure<T>("getA_no_rvo1", getA_no_rvo1<T>, calls);
+    measure<T>("getA_no_rvo2", getA_no_rvo2<T>, calls);
+}
+
+int main(int argc, char *argv[])
+{
+    long calls = argc > 1 ? atol(argv[1]) : 1000000;
+    cond = argc > 2; // 始终走else分支，除非额外传入参数
+    if (calls <= 0)
+    {
+        cerr << "用法: " << argv[0] << " [调用次数]\n";
+        return 1;
+    }
+
+    cout << "编译选项 " << OPT_LEVEL << "，每种方式调用 " << calls << " 次\n";
+    run<Buffer>("Buffer（4KiB内联数组）", calls);
+    run<BigString>("BigString（4KiB String，转移需要分配）", calls);
+    return 0;
+}
@@ -0,0 +1,138 @@
+// To compile: g++ -std=c++17 -O2 shape_collection_benchmark.cpp -o shape_collection_bench
+// To run:     ./shape_collection_bench [形状个数...]   例如 ./shape_collection_bench 1000000 10000000 100000000
+//             （1亿个形状时指针版本约需5GB内存）
+
+// 程序功能：对比两种批量求面积的方式的遍历吞吐量
+//   1. vector<unique_ptr<Shape>>：每个形状单独在堆上分配，遍历时经指针访问并调用虚函数
+//      分别测量“按分配顺序遍历”（指针与内存地址顺序一致，最好情况）和“打乱顺序后遍历”
+//      （模拟长期插入/删除后指针指向分散的堆对象）
+//   2. shape_collection<Circle, Triangle>：按类型分区的连续数组，for_each_shape逐类型紧凑循环
+// 每种方式重复遍历，直到累计处理的形状数不少于1亿个，输出ns/形状和百万形状/秒
+#include <algorithm> // 提供std::shuffle
+#include <chrono>    // 提供计时功能
+#include <cmath>     // 提供std::fabs
+#include <cstdlib>   // 提供std::atol
+#include <iomanip>   // 提供setw/setprecision
+#include <iostream>
+#include <memory>    // 提供std::unique_ptr
+#include <random>    // 提供随机数（随机混合形状类型）
+#include <vector>
+#include "../code/02 - object lifetime and raii/shape_dispatch.hpp"
+#include "../code/02 - object lifetime and raii/shape_collection.hpp"
+
+using namespace std;
+
+using pointer_vector = vector<unique_ptr<dynamic_shapes::Shape>>;
+using collection = shape_collection<static_shapes::Circle, static_shapes::Triangle>;
+
+double sum_pointers(const pointer_vector &shapes)
+{
+    double total = 0;
+    for (const auto &s : shapes)
+    {
+        total += s->area();
+    }
+    return total;
+}
+
+double sum_collection(const collection &shapes)
+{
+    double total = 0;
+    shapes.for_each_shape([&total](const auto &s) { total += s.area(); });
+    return total;
+}
+
+/**
+ * @brief 重复调用fn，直到累计处理的形状数不少于1亿，输出平均耗时，返回最后一次的面积总和
+ */
+template <typename Fn>
+double measure(const char *name, size_t count, Fn fn)
+{
+    const size_t passes = max<size_t>(1, 100000000 / count);
+    double total = 0;
+    auto start = chrono::steady_clock::now();
+    for (size_t p = 0; p < passes; ++p)
+    {
+        total = fn();
+    }
+    auto elapsed = chrono::steady_clock::now() - start;
+    double ns = chrono::duration<double, nano>(elapsed).count() / (passes * count);
+    cout << "  " << left << setw(28) << name << right << fixed << setprecision(3)
+         << setw(8) << ns << " ns/形状" << setprecision(1) << setw(10) << 1e3 / ns
+         << " M形状/秒\n";
+    return total;
+}
+
+bool close_enough(double a, double b)
+{
+    return fabs(a - b) <= 1e-9 * fabs(a);
+}
+
+int run(size_t count)
+{
+    cout << count << " 个形状（圆形与三角形随机各半）\n";
+    mt19937 gen(42);
+    bernoulli_distribution is_circle(0.5);
+
+    pointer_vector pointers;
+    pointers.reserve(count);
+    collection shapes;
+    for (size_t i = 0; i < count; ++i)
+    {
+        double s = 1.0 + static_cast<double>(i & 1023) * 0.001;
+        if (is_circle(gen))
+        {
+            pointers.push_back(make_unique<dynamic_shapes::Circle>(s));
+            shapes.emplace<static_shapes::Circle>(s);
+        }
+        else
+        {
+            pointers.push_back(make_unique<dynamic_shapes::Triangle>(s, 2.0));
+            shapes.emplace<static_shapes::Triangle>(s, 2.0);
+        }
+    }
+
+    double a = measure("unique_ptr（分配顺序）", count,
+                       [&] { return sum_pointers(pointers); });
+    shuffle(pointers.begin(), pointers.end(), gen);
+    double b = measure("unique_ptr（打乱顺序）", count,
+                       [&] { return sum_pointers(pointers); });
+    double c = measure("shape_collection", count,
+                       [&] { return sum_collection(shapes); });
+
+    // 求和顺序不同，浮点结果只要求在舍入误差范围内一致
+    if (!close_enough(a, b) || !close_enough(a, c))
+    {
+        cerr << "面积总和不一致: " << a << ' ' << b << ' ' << c << '\n';
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    vector<size_t> counts;
+    for (int i = 1; i < argc; ++i)
+    {
+        long n = atol(argv[i]);
+        if (n <= 0)
+        {
+            cerr << "用法: " << argv[0] << " [形状个数...]\n";
+            return 1;
+        }
+        counts.push_back(static_cast<size_t>(n));
+    }
+    if (counts.empty())
+    {
+        counts = {1000000, 10000000};
+    }
+
+    for (size_t count : counts)
+    {
+        if (run(count) != 0)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
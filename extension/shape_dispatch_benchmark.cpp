@@ -0,0 +1,163 @@
+// To compile: g++ -std=c++17 -O2 shape_dispatch_benchmark.cpp -o shape_dispatch_bench
+// To run:     ./shape_dispatch_bench [形状对数]
+
+// 程序功能：对比process_shape的三种分派方式（见shape_dispatch.hpp）处理大量形状对的速度
+//   场景1：与temporary_object.cpp相同，每次传入临时的Circle和Triangle（类型在编译期已知）
+//          虚函数 vs variant vs CRTP
+//   场景2：形状类型在运行时随机混合（从形状池中取出），CRTP无法使用，只比较虚函数 vs variant
+//          虚函数版本的形状池是vector<unique_ptr<Shape>>，variant版本是vector<shape>（按值连续存放）
+// 每种方式都通过NOINLINE的包装函数调用，模拟process_shape位于另一个编译单元的情况，
+// 避免编译器在调用处看到具体类型后直接去虚化；三种方式的面积总和必须一致
+#include <chrono>  // 提供计时功能
+#include <cstdlib> // 提供std::atol
+#include <iomanip> // 提供setw/setprecision
+#include <iostream>
+#include <memory>  // 提供std::unique_ptr
+#include <random>  // 提供随机数（生成形状池）
+#include <vector>
+#include "../code/02 - object lifetime and raii/shape_dispatch.hpp"
+
+using namespace std;
+
+#define NOINLINE __attribute__((noinline))
+
+// ===== 包装函数：参数类型即各方式的接口 =====
+NOINLINE Result call_virtual(const dynamic_shapes::Shape &s1,
+                             const dynamic_shapes::Shape &s2)
+{
+    return dynamic_shapes::process_shape(s1, s2);
+}
+
+NOINLINE Result call_variant(const static_shapes::shape &s1,
+                             const static_shapes::shape &s2)
+{
+    return static_shapes::process_shape(s1, s2);
+}
+
+NOINLINE Result call_crtp(const static_shapes::Circle &s1,
+                          const static_shapes::Triangle &s2)
+{
+    return static_shapes::process_shape(s1, s2);
+}
+
+// 第i个形状对的尺寸：随i变化，防止编译器把整个循环常量折叠
+inline double size_of(long i)
+{
+    return 1.0 + static_cast<double>(i & 1023) * 0.001;
+}
+
+template <typename Fn>
+double timed(const char *name, long pairs, Fn fn)
+{
+    auto start = chrono::steady_clock::now();
+    double total = fn();
+    auto elapsed = chrono::steady_clock::now() - start;
+    double ns = chrono::duration<double, nano>(elapsed).count() / pairs;
+    cout << "  " << left << setw(12) << name << right << fixed << setprecision(2)
+         << setw(8) << ns << " ns/对  (面积总和 " << setprecision(6) << total << ")\n";
+    return total;
+}
+
+int main(int argc, char *argv[])
+{
+    long pairs = argc > 1 ? atol(argv[1]) : 100000000;
+    if (pairs <= 0)
+    {
+        cerr << "用法: " << argv[0] << " [形状对数]\n";
+        return 1;
+    }
+
+    cout << "场景1：process_shape(Circle(), Triangle())，" << pairs << " 对\n";
+    double v1 = timed("virtual", pairs, [pairs] {
+        double total = 0;
+        for (long i = 0; i < pairs; ++i)
+        {
+            double s = size_of(i);
+            total += call_virtual(dynamic_shapes::Circle(s),
+                                  dynamic_shapes::Triangle(s, 2.0)).area;
+        }
+        return total;
+    });
+    double v2 = timed("variant", pairs, [pairs] {
+        double total = 0;
+        for (long i = 0; i < pairs; ++i)
+        {
+            double s = size_of(i);
+            total += call_variant(static_shapes::Circle(s),
+                                  static_shapes::Triangle(s, 2.0)).area;
+        }
+        return total;
+    });
+    double v3 = timed("CRTP", pairs, [pairs] {
+        double total = 0;
+        for (long i = 0; i < pairs; ++i)
+        {
+            double s = size_of(i);
+            total += call_crtp(static_shapes::Circle(s),
+                               static_shapes::Triangle(s, 2.0)).area;
+        }
+        return total;
+    });
+    if (v1 != v2 || v1 != v3)
+    {
+        cerr << "场景1的结果不一致\n";
+        return 1;
+    }
+
+    // 场景2：4096个随机类型的形状，按预先生成的随机下标成对处理
+    constexpr size_t pool_size = 4096;
+    constexpr size_t index_count = 1 << 16;
+    mt19937 gen(2024);
+    bernoulli_distribution is_circle(0.5);
+    uniform_int_distribution<size_t> pick(0, pool_size - 1);
+
+    vector<unique_ptr<dynamic_shapes::Shape>> dynamic_pool;
+    vector<static_shapes::shape> static_pool;
+    for (size_t i = 0; i < pool_size; ++i)
+    {
+        double s = size_of(static_cast<long>(i));
+        if (is_circle(gen))
+        {
+            dynamic_pool.push_back(make_unique<dynamic_shapes::Circle>(s));
+            static_pool.emplace_back(static_shapes::Circle(s));
+        }
+        else
+        {
+            dynamic_pool.push_back(make_unique<dynamic_shapes::Triangle>(s, 2.0));
+            static_pool.emplace_back(static_shapes::Triangle(s, 2.0));
+        }
+    }
+    vector<size_t> indices(index_count);
+    for (auto &idx : indices)
+    {
+        idx = pick(gen);
+    }
+
+    cout << "场景2：运行时随机混合的类型，" << pairs << " 对\n";
+    double m1 = timed("virtual", pairs, [&] {
+        double total = 0;
+        for (long i = 0; i < pairs; ++i)
+        {
+            size_t k = static_cast<size_t>(i) % (index_count - 1);
+            total += call_virtual(*dynamic_pool[indices[k]],
+                                  *dynamic_pool[indices[k + 1]]).area;
+        }
+        return total;
+    });
+    double m2 = timed("variant", pairs, [&] {
+        double total = 0;
+        for (long i = 0; i < pairs; ++i)
+        {
+            size_t k = static_cast<size_t>(i) % (index_count - 1);
+            total += call_variant(static_pool[indices[k]],
+                                  static_pool[indices[k + 1]]).area;
+        }
+        return total;
+    });
+    if (m1 != m2)
+    {
+        cerr << "场景2的结果不一致\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,258 @@
+// 列式（SoA，structure of arrays）容器头文件：把Student/Product这类记录的每个字段存放在各自的数组中
+// 背景：vector<Product>是结构体数组（AoS），只扫描price一列时，每读4字节的price都要把整条记录
+//       所在的缓存行读入，name和stock白白占用内存带宽；字段交错存放也使编译器难以向量化
+// 核心特性：
+//   1. soa_vector<Ts...>：第I列是Ts...中第I个类型的连续数组，每列单独按缓存行（64字节）对齐分配
+//   2. column<I>()返回第I列的指针（并告知编译器已对齐），按列扫描是紧凑的单一类型循环，可以向量化
+//   3. operator[]返回行代理row_ref：get<I>()得到各列元素的引用，可以整行赋值或读出为tuple
+//   4. push_back/emplace_back/reserve/resize/clear，接口与vector相同；扩容时逐列memcpy
+// 限制：列类型必须可平凡复制（字符串字段使用std::array<char, N>）
+// 用法：
+//     soa_vector<std::array<char, 10>, float, int> products; // name, price, stock
+//     products.push_back({...}, 9.5f, 100);
+//     const float *price = products.column<1>();
+#ifndef SOA_VECTOR_HPP
+#define SOA_VECTOR_HPP
+
+#include <cstddef>     // 提供size_t
+#include <cstring>     // 提供memcpy
+#include <new>         // 提供operator new(size_t, align_val_t)
+#include <tuple>       // 提供std::tuple/std::tuple_element_t
+#include <type_traits> // 提供std::is_trivially_copyable_v
+#include <utility>     // 提供std::index_sequence
+
+/**
+ * @brief 列式存储的记录容器
+ * @tparam Ts 各列（字段）的类型
+ */
+template <typename... Ts>
+class soa_vector
+{
+    static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one column");
+    static_assert((std::is_trivially_copyable_v<Ts> && ...), "columns must be trivially copyable");
+
+public:
+    static constexpr size_t alignment = 64; // 每列的对齐要求（缓存行大小）
+
+    template <size_t I>
+    using column_type = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+    /**
+     * @brief 行代理：持有一行中各列元素的引用（Ref为Ts&或const Ts&）
+     */
+    template <typename... Refs>
+    class basic_row
+    {
+    public:
+        explicit basic_row(Refs... refs) : refs_(refs...) {}
+
+        template <size_t I>
+        decltype(auto) get() const { return std::get<I>(refs_); }
+
+        // 读出为值
+        std::tuple<Ts...> value() const { return std::tuple<Ts...>(refs_); }
+
+        // 整行赋值（仅非const行）
+        const basic_row &operator=(const std::tuple<Ts...> &values) const
+        {
+            refs_ = values;
+            return *this;
+        }
+
+    private:
+        mutable std::tuple<Refs...> refs_;
+    };
+
+    using row_ref = basic_row<Ts &...>;
+    using const_row_ref = basic_row<const Ts &...>;
+
+    soa_vector() = default;
+
+    soa_vector(const soa_vector &other) { assign_from(other); }
+
+    soa_vector(soa_vector &&other) noexcept
+        : columns_(other.columns_), size_(other.size_), capacity_(other.capacity_)
+    {
+        other.columns_ = {};
+        other.size_ = other.capacity_ = 0;
+    }
+
+    soa_vector &operator=(soa_vector other) noexcept
+    {
+        std::swap(columns_, other.columns_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        return *this;
+    }
+
+    ~soa_vector() { release(columns_); }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+
+    /**
+     * @brief 第I列的首地址（按alignment对齐）
+     */
+    template <size_t I>
+    column_type<I> *column()
+    {
+        return static_cast<column_type<I> *>(
+            __builtin_assume_aligned(std::get<I>(columns_), alignment));
+    }
+
+    template <size_t I>
+    const column_type<I> *column() const
+    {
+        return static_cast<const column_type<I> *>(
+            __builtin_assume_aligned(std::get<I>(columns_), alignment));
+    }
+
+    row_ref operator[](size_t i) { return row_at<row_ref>(i, indices()); }
+    const_row_ref operator[](size_t i) const { return row_at<const_row_ref>(i, indices()); }
+
+    void reserve(size_t n)
+    {
+        if (n > capacity_)
+        {
+            reallocate(n);
+        }
+    }
+
+    /**
+     * @brief 改变行数；新增的行值初始化
+     */
+    void resize(size_t n)
+    {
+        reserve(n);
+        for (size_t i = size_; i < n; ++i)
+        {
+            construct_row(columns_, i, Ts()...);
+        }
+        size_ = n;
+    }
+
+    void clear() { size_ = 0; }
+
+    void push_back(const Ts &...values)
+    {
+        if (size_ == capacity_)
+        {
+            // values可能引用本容器中的元素（如v.push_back(v[3].get<0>(), v[3].get<1>())）：
+            // 先在新分配的列中构造新行，再释放旧列
+            const size_t n = capacity_ == 0 ? 16 : capacity_ * 2;
+            std::tuple<Ts *...> fresh = allocate_copy(n);
+            construct_row(fresh, size_, values...);
+            adopt(fresh, n);
+        }
+        else
+        {
+            construct_row(columns_, size_, values...);
+        }
+        ++size_;
+    }
+
+    row_ref emplace_back(const Ts &...values)
+    {
+        push_back(values...);
+        return (*this)[size_ - 1];
+    }
+
+    void pop_back() { --size_; }
+
+private:
+    using index_seq = std::index_sequence_for<Ts...>;
+    static constexpr index_seq indices() { return index_seq(); }
+
+    template <typename Row, size_t... I>
+    Row row_at(size_t i, std::index_sequence<I...>) const
+    {
+        return Row(std::get<I>(columns_)[i]...);
+    }
+
+    static void construct_row(std::tuple<Ts *...> &cols, size_t i, const Ts &...values)
+    {
+        construct_row_impl(cols, i, indices(), values...);
+    }
+
+    template <size_t... I>
+    static void construct_row_impl(std::tuple<Ts *...> &cols, size_t i, std::index_sequence<I...>,
+                                   const Ts &...values)
+    {
+        ((void)::new (static_cast<void *>(std::get<I>(cols) + i)) Ts(values), ...);
+    }
+
+    // 为每一列分配n个元素的空间，逐列复制已有的元素
+    void reallocate(size_t n) { adopt(allocate_copy(n), n); }
+
+    std::tuple<Ts *...> allocate_copy(size_t n) const
+    {
+        std::tuple<Ts *...> fresh;
+        allocate(fresh, n, indices());
+        copy_columns(fresh, columns_, size_, indices());
+        return fresh;
+    }
+
+    // 释放旧列，改用fresh（容量为n）
+    void adopt(std::tuple<Ts *...> fresh, size_t n)
+    {
+        release(columns_);
+        columns_ = fresh;
+        capacity_ = n;
+    }
+
+    template <size_t... I>
+    static void allocate(std::tuple<Ts *...> &cols, size_t n, std::index_sequence<I...>)
+    {
+        cols = {};
+        try
+        {
+            ((std::get<I>(cols) = static_cast<Ts *>(
+                  ::operator new(n * sizeof(Ts), std::align_val_t(alignment)))),
+             ...);
+        }
+        catch (...)
+        {
+            release(cols);
+            throw;
+        }
+    }
+
+    template <size_t... I>
+    static void copy_columns(std::tuple<Ts *...> &to, const std::tuple<Ts *...> &from, size_t n,
+                             std::index_sequence<I...>)
+    {
+        if (n != 0)
+        {
+            (memcpy(std::get<I>(to), std::get<I>(from), n * sizeof(Ts)), ...);
+        }
+    }
+
+    static void release(std::tuple<Ts *...> &cols)
+    {
+        std::apply(
+            [](auto *...p) {
+                ((p != nullptr ? ::operator delete(static_cast<void *>(p), std::align_val_t(alignment))
+                               : void()),
+                 ...);
+            },
+            cols);
+        cols = {};
+    }
+
+    void assign_from(const soa_vector &other)
+    {
+        if (other.size_ != 0)
+        {
+            allocate(columns_, other.size_, indices());
+            copy_columns(columns_, other.columns_, other.size_, indices());
+            size_ = capacity_ = other.size_;
+        }
+    }
+
+    std::tuple<Ts *...> columns_{}; // 每列一个数组
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+};
+
+#endif // SOA_VECTOR_HPP
@@ -0,0 +1,246 @@
+// To compile: g++ -std=c++17 -O3 -march=native soa_vector_benchmark.cpp -o soa_vector_bench
+// To run:     ./soa_vector_bench [记录数]
+
+// 程序功能：对比结构体数组（vector<Product>/vector<Student>）与列式存储（soa_vector）的按列扫描速度
+//   扫描1：所有商品价格之和（只读price一列）
+//   扫描2：筛选age > 18的学生，统计人数与分数之和（读age和score两列）
+// 两种存储使用同一个扫描函数（按下标取字段的lambda），区别只在于数据布局；
+// 浮点求和使用8个独立的部分和，使编译器不需要-ffast-math也能向量化；两种布局的结果必须完全相同
+// 每种扫描重复执行，直到累计处理的记录数不少于1亿，输出ns/记录和GB/s（按实际占用的内存计算）
+#include <array>   // 提供std::array（列式存储中的名称字段）
+#include <chrono>  // 提供计时功能
+#include <cstdlib> // 提供std::atol
+#include <cstring> // 提供memcpy
+#include <iomanip> // 提供setw/setprecision
+#include <iostream>
+#include <random>  // 提供随机数
+#include <vector>
+#include "soa_vector.hpp"
+
+using namespace std;
+
+// 与memcmp.cpp相同的结构体
+struct Product
+{
+    char name[10]; // 商品名称
+    float price;   // 价格
+    int stock;     // 库存
+};
+
+// 与memcpy.cpp相同的结构体
+struct Student
+{
+    char name[20]; // 姓名
+    int age;       // 年龄
+    float score;   // 分数
+};
+
+using product_columns = soa_vector<array<char, 10>, float, int>; // name, price, stock
+using student_columns = soa_vector<array<char, 20>, int, float>; // name, age, score
+enum { name_col = 0, price_col = 1, stock_col = 2 };
+enum { age_col = 1, score_col = 2 };
+
+constexpr size_t lanes = 8; // 部分和的个数
+
+/**
+ * @brief 求price(0) + ... + price(n-1)，price(i)返回第i条记录的价格
+ */
+template <typename Get>
+double sum_prices(size_t n, Get price)
+{
+    float acc[lanes] = {};
+    size_t i = 0;
+    for (; i + lanes <= n; i += lanes)
+    {
+        for (size_t k = 0; k < lanes; ++k)
+        {
+            acc[k] += price(i + k);
+        }
+    }
+    for (; i < n; ++i)
+    {
+        acc[i % lanes] += price(i);
+    }
+    double total = 0;
+    for (float a : acc)
+    {
+        total += a;
+    }
+    return total;
+}
+
+struct filter_result
+{
+    long count;
+    double score;
+
+    bool operator==(const filter_result &o) const { return count == o.count && score == o.score; }
+};
+
+/**
+ * @brief 统计age(i) > 18的记录数及其score(i)之和（无分支：不满足条件的记录加0）
+ */
+template <typename Age, typename Score>
+filter_result filter_adults(size_t n, Age age, Score score)
+{
+    int count[lanes] = {};
+    float acc[lanes] = {};
+    size_t i = 0;
+    for (; i + lanes <= n; i += lanes)
+    {
+        for (size_t k = 0; k < lanes; ++k)
+        {
+            float s = score(i + k); // 先无条件读出，条件只用于选择
+            bool adult = age(i + k) > 18;
+            count[k] += adult;
+            acc[k] += adult ? s : 0.0f;
+        }
+    }
+    for (; i < n; ++i)
+    {
+        float s = score(i);
+        bool adult = age(i) > 18;
+        count[i % lanes] += adult;
+        acc[i % lanes] += adult ? s : 0.0f;
+    }
+    filter_result r{0, 0};
+    for (size_t k = 0; k < lanes; ++k)
+    {
+        r.count += count[k];
+        r.score += acc[k];
+    }
+    return r;
+}
+
+/**
+ * @brief 重复调用fn，直到累计处理的记录数不少于1亿，输出平均耗时，返回最后一次的结果
+ */
+template <typename Fn>
+auto measure(const char *name, size_t count, size_t bytes, Fn fn)
+{
+    const size_t passes = max<size_t>(1, 100000000 / count);
+    auto result = fn();
+    auto start = chrono::steady_clock::now();
+    for (size_t p = 0; p < passes; ++p)
+    {
+        result = fn();
+    }
+    auto elapsed = chrono::steady_clock::now() - start;
+    double ns = chrono::duration<double, nano>(elapsed).count() / passes;
+    cout << "  " << left << setw(24) << name << right << fixed << setprecision(3)
+         << setw(8) << ns / count << " ns/记录" << setprecision(2) << setw(8)
+         << bytes / ns << " GB/s\n";
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    long arg = argc > 1 ? atol(argv[1]) : 10000000;
+    if (arg <= 0)
+    {
+        cerr << "用法: " << argv[0] << " [记录数]\n";
+        return 1;
+    }
+    const size_t n = static_cast<size_t>(arg);
+
+    mt19937 gen(5);
+    uniform_int_distribution<int> cents(0, 99999);
+    uniform_int_distribution<int> age(6, 30);
+    uniform_int_distribution<int> score(0, 100);
+
+    vector<Product> products(n);
+    vector<Student> students(n);
+    product_columns product_soa;
+    student_columns student_soa;
+    product_soa.reserve(n);
+    student_soa.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        Product &p = products[i];
+        memcpy(p.name, "Phone", 6);
+        p.price = cents(gen) / 100.0f;
+        p.stock = static_cast<int>(i % 500);
+        array<char, 10> pname{};
+        memcpy(pname.data(), p.name, sizeof p.name);
+        product_soa.push_back(pname, p.price, p.stock);
+
+        Student &s = students[i];
+        memcpy(s.name, "ZhangSan", 9);
+        s.age = age(gen);
+        s.score = static_cast<float>(score(gen));
+        array<char, 20> sname{};
+        memcpy(sname.data(), s.name, sizeof s.name);
+        student_soa.push_back(sname, s.age, s.score);
+    }
+
+    // 行代理的基本检查：读出、整行赋值
+    {
+        auto row = product_soa[n - 1];
+        if (row.get<price_col>() != products[n - 1].price ||
+            row.get<stock_col>() != products[n - 1].stock)
+        {
+            cerr << "行代理读出的数据不一致\n";
+            return 1;
+        }
+        auto saved = row.value();
+        row = make_tuple(array<char, 10>{}, 1.5f, 7);
+        bool ok = product_soa.column<price_col>()[n - 1] == 1.5f &&
+                  product_soa.column<stock_col>()[n - 1] == 7;
+        row = saved;
+        if (!ok)
+        {
+            cerr << "行代理赋值失败\n";
+            return 1;
+        }
+    }
+
+    // 扩容时追加本容器中的元素：旧列要在新行构造之后才释放
+    {
+        soa_vector<int, float> v;
+        for (int i = 0; i < 16; ++i)
+        {
+            v.push_back(i, i * 0.5f);
+        }
+        v.push_back(v[3].get<0>(), v[3].get<1>()); // 此时已满，会扩容
+        if (v.size() != 17 || v[16].get<0>() != 3 || v[16].get<1>() != 1.5f)
+        {
+            cerr << "追加自身元素的结果不正确\n";
+            return 1;
+        }
+    }
+
+    cout << n << " 条记录，sizeof(Product) = " << sizeof(Product)
+         << "，sizeof(Student) = " << sizeof(Student) << '\n';
+
+    cout << "扫描1：价格之和\n";
+    double a1 = measure("vector<Product>", n, n * sizeof(Product), [&] {
+        const Product *p = products.data();
+        return sum_prices(n, [p](size_t i) { return p[i].price; });
+    });
+    double b1 = measure("soa_vector（price列）", n, n * sizeof(float), [&] {
+        const float *price = product_soa.column<price_col>();
+        return sum_prices(n, [price](size_t i) { return price[i]; });
+    });
+
+    cout << "扫描2：age > 18的人数与分数之和\n";
+    filter_result a2 = measure("vector<Student>", n, n * sizeof(Student), [&] {
+        const Student *s = students.data();
+        return filter_adults(n, [s](size_t i) { return s[i].age; },
+                             [s](size_t i) { return s[i].score; });
+    });
+    filter_result b2 = measure("soa_vector（age、score列）", n, n * (sizeof(int) + sizeof(float)), [&] {
+        const int *ages = student_soa.column<age_col>();
+        const float *scores = student_soa.column<score_col>();
+        return filter_adults(n, [ages](size_t i) { return ages[i]; },
+                             [scores](size_t i) { return scores[i]; });
+    });
+
+    if (a1 != b1 || !(a2 == b2))
+    {
+        cerr << "两种布局的扫描结果不一致\n";
+        return 1;
+    }
+    cout << "价格之和 " << setprecision(2) << a1 << "，成年学生 " << a2.count
+         << " 人，分数之和 " << a2.score << '\n';
+    return 0;
+}
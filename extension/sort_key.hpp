@@ -0,0 +1,307 @@
+// 保序字节键（order-preserving key）头文件：把排序键编码为字节串，使memcmp的结果与字段的大小关系一致
+// 背景：memcmp.cpp的场景4/5说明直接对结构体做memcmp有两个问题——
+//       填充字节参与比较，有符号整数按原始字节比较时顺序错误（-1的字节比1大）
+// 核心特性：
+//   1. encode系列函数把字段按大端序写入键：
+//      - 无符号整数：直接按大端序
+//      - 有符号整数：翻转符号位后按大端序（负数排在正数之前）
+//      - 浮点数：正数翻转符号位、负数按位取反，得到IEEE全序（-NaN < -inf < ... < -0 < +0 < ... < +inf < +NaN）
+//      - 定长字符串：复制到'\0'为止，其余补0（短串排在以它为前缀的长串之前）
+//      - encode_descending：按位取反，得到降序
+//   2. byte_key<N>：紧密排列的N字节键，没有填充；比较等价于一次memcmp
+//      （开头按8字节大端整数比较，长键的其余部分用SSE2每次比较16字节）
+//   3. radix_sort：对keyed<N, Payload>数组做MSD基数排序（逐字节分桶，小桶退化为插入排序）
+#ifndef SORT_KEY_HPP
+#define SORT_KEY_HPP
+
+#include <algorithm>   // 提供std::copy/std::fill
+#include <cstddef>     // 提供size_t
+#include <cstdint>     // 提供uint32_t/uint64_t
+#include <cstring>     // 提供memcpy/memcmp/memset
+#include <type_traits> // 提供std::is_integral_v/make_unsigned_t等
+#include <vector>      // 提供std::vector（基数排序的临时缓冲区）
+
+#ifdef __SSE2__
+#include <emmintrin.h> // 提供SSE2指令
+#endif
+
+namespace sortkey
+{
+
+// 把无符号整数按大端序写入out，返回写入后的位置
+template <typename U>
+unsigned char *store_big_endian(unsigned char *out, U value)
+{
+    for (size_t i = sizeof(U); i != 0; --i)
+    {
+        out[i - 1] = static_cast<unsigned char>(value);
+        value = static_cast<U>(value >> 8);
+    }
+    return out + sizeof(U);
+}
+
+/**
+ * @brief 把算术类型的值转换为同样宽度的无符号整数，使无符号比较的结果与原值的大小关系一致
+ */
+template <typename T>
+auto ordered_bits(T value)
+{
+    static_assert(std::is_arithmetic_v<T>, "only arithmetic types are supported");
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        return static_cast<unsigned char>(value);
+    }
+    else if constexpr (std::is_integral_v<T>)
+    {
+        using U = std::make_unsigned_t<T>;
+        U bits = static_cast<U>(value);
+        if constexpr (std::is_signed_v<T>)
+        {
+            bits ^= static_cast<U>(U(1) << (sizeof(U) * 8 - 1)); // 翻转符号位
+        }
+        return bits;
+    }
+    else
+    {
+        static_assert(sizeof(T) == 4 || sizeof(T) == 8, "unsupported floating-point type");
+        using U = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+        U bits;
+        memcpy(&bits, &value, sizeof bits);
+        const U sign = U(1) << (sizeof(U) * 8 - 1);
+        // 负数：按位取反（绝对值越大越小）；正数：只翻转符号位（排在所有负数之后）
+        return (bits & sign) ? static_cast<U>(~bits) : static_cast<U>(bits | sign);
+    }
+}
+
+/**
+ * @brief 按升序编码一个算术类型字段，返回写入后的位置
+ */
+template <typename T>
+unsigned char *encode(unsigned char *out, T value)
+{
+    return store_big_endian(out, ordered_bits(value));
+}
+
+/**
+ * @brief 按降序编码一个算术类型字段
+ */
+template <typename T>
+unsigned char *encode_descending(unsigned char *out, T value)
+{
+    auto bits = ordered_bits(value);
+    return store_big_endian(out, static_cast<decltype(bits)>(~bits));
+}
+
+/**
+ * @brief 按升序编码定长字符串字段（如Product::name），占width字节
+ * 复制到'\0'为止，其余补0；'\0'之后的残留字节不会影响比较
+ */
+inline unsigned char *encode_string(unsigned char *out, const char *s, size_t width)
+{
+    size_t len = 0;
+    while (len < width && s[len] != '\0')
+    {
+        ++len;
+    }
+    memcpy(out, s, len);
+    memset(out + len, 0, width - len);
+    return out + width;
+}
+
+// 比较从a、b开始的8个字节（按大端整数比较，等价于memcmp）
+inline int compare_word(const unsigned char *a, const unsigned char *b)
+{
+    uint64_t x, y;
+    memcpy(&x, a, 8);
+    memcpy(&y, b, 8);
+    if (x == y)
+    {
+        return 0;
+    }
+    return __builtin_bswap64(x) < __builtin_bswap64(y) ? -1 : 1;
+}
+
+/**
+ * @brief 比较两段n字节的内存，返回值的符号与memcmp相同
+ * 排序键的前几个字节通常就能分出大小，因此先按8字节整数比较开头；
+ * 键较长时其余部分用SSE2每次比较16字节。不足一整块的尾部与前一块重叠比较
+ * （重叠部分已知相同，不影响结果），整个过程不需要逐字节循环或调用memcmp
+ */
+inline int compare_bytes(const unsigned char *a, const unsigned char *b, size_t n)
+{
+    if (n < 8)
+    {
+        return memcmp(a, b, n);
+    }
+    if (int c = compare_word(a, b))
+    {
+        return c;
+    }
+    size_t i = 8;
+#ifdef __SSE2__
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+        unsigned diff = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) ^ 0xFFFFu;
+        if (diff != 0)
+        {
+            size_t k = i + static_cast<size_t>(__builtin_ctz(diff));
+            return static_cast<int>(a[k]) - static_cast<int>(b[k]);
+        }
+    }
+#endif
+    for (; i + 8 <= n; i += 8)
+    {
+        if (int c = compare_word(a + i, b + i))
+        {
+            return c;
+        }
+    }
+    return i == n ? 0 : compare_word(a + n - 8, b + n - 8);
+}
+
+/**
+ * @brief N字节的保序键：字段依次编码、紧密排列，没有填充字节
+ */
+template <size_t N>
+struct byte_key
+{
+    unsigned char bytes[N];
+
+    friend bool operator<(const byte_key &lhs, const byte_key &rhs)
+    {
+        return compare_bytes(lhs.bytes, rhs.bytes, N) < 0;
+    }
+    friend bool operator==(const byte_key &lhs, const byte_key &rhs)
+    {
+        return compare_bytes(lhs.bytes, rhs.bytes, N) == 0;
+    }
+    friend bool operator!=(const byte_key &lhs, const byte_key &rhs)
+    {
+        return !(lhs == rhs);
+    }
+};
+
+/**
+ * @brief 键与附带数据（通常是原记录的下标）
+ * 排序时只移动这个小结构，而不是整条记录；排序后再按payload取回记录
+ */
+template <size_t N, typename Payload = uint32_t>
+struct keyed
+{
+    byte_key<N> key;
+    Payload payload;
+
+    friend bool operator<(const keyed &lhs, const keyed &rhs) { return lhs.key < rhs.key; }
+};
+
+namespace detail
+{
+
+// 从第depth个字节开始比较两条记录的键（前depth个字节已知相同）
+template <size_t N, typename P>
+bool less_from(const keyed<N, P> &a, const keyed<N, P> &b, size_t depth)
+{
+    return compare_bytes(a.key.bytes + depth, b.key.bytes + depth, N - depth) < 0;
+}
+
+template <size_t N, typename P>
+void insertion_sort(keyed<N, P> *first, keyed<N, P> *last, size_t depth)
+{
+    for (keyed<N, P> *i = first + 1; i < last; ++i)
+    {
+        keyed<N, P> tmp = *i;
+        keyed<N, P> *j = i;
+        for (; j != first && less_from(tmp, *(j - 1), depth); --j)
+        {
+            *j = *(j - 1);
+        }
+        *j = tmp;
+    }
+}
+
+// MSD基数排序：按第depth个字节把data中的n条记录稳定地分配到other的256个桶中，
+// 再交换两个缓冲区的角色递归处理每个桶（不需要每层都把数据复制回去）
+// in_place为true表示data位于调用者的数组中；排好序的区段若位于临时缓冲区，最后复制回other
+template <size_t N, typename P>
+void msd_radix_sort(keyed<N, P> *data, keyed<N, P> *other, size_t n, size_t depth,
+                    bool in_place)
+{
+    constexpr size_t small = 32; // 小于此规模时插入排序更快
+    size_t count[256];
+    for (;;)
+    {
+        if (n < 2 || depth == N)
+        {
+            break;
+        }
+        if (n < small)
+        {
+            insertion_sort(data, data + n, depth);
+            break;
+        }
+
+        std::fill(count, count + 256, size_t(0));
+        for (size_t i = 0; i < n; ++i)
+        {
+            ++count[data[i].key.bytes[depth]];
+        }
+        // 所有键在这个字节上都相同（如小整数的高位字节）：直接比较下一个字节，不用搬运数据
+        if (count[data[0].key.bytes[depth]] == n)
+        {
+            ++depth;
+            continue;
+        }
+
+        size_t offset[256];
+        size_t sum = 0;
+        for (size_t b = 0; b < 256; ++b)
+        {
+            offset[b] = sum;
+            sum += count[b];
+        }
+        for (size_t i = 0; i < n; ++i)
+        {
+            other[offset[data[i].key.bytes[depth]]++] = data[i];
+        }
+
+        size_t start = 0;
+        for (size_t b = 0; b < 256; ++b)
+        {
+            if (count[b] != 0)
+            {
+                msd_radix_sort(other + start, data + start, count[b], depth + 1, !in_place);
+            }
+            start += count[b];
+        }
+        return;
+    }
+    if (!in_place)
+    {
+        std::copy(data, data + n, other);
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief 按键对记录做基数排序（稳定排序：键相同的记录保持原有的相对顺序）
+ */
+template <size_t N, typename P>
+void radix_sort(keyed<N, P> *first, keyed<N, P> *last)
+{
+    size_t n = static_cast<size_t>(last - first);
+    std::vector<keyed<N, P>> scratch(n);
+    detail::msd_radix_sort(first, scratch.data(), n, 0, true);
+}
+
+template <size_t N, typename P>
+void radix_sort(std::vector<keyed<N, P>> &records)
+{
+    radix_sort(records.data(), records.data() + records.size());
+}
+
+} // namespace sortkey
+
+#endif // SORT_KEY_HPP
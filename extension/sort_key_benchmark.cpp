@@ -0,0 +1,173 @@
+// To compile: g++ -std=c++17 -O2 sort_key_benchmark.cpp -o sort_key_bench
+// To run:     ./sort_key_bench [记录数]
+
+// 程序功能：按（价格升序，库存降序，名称升序）对memcmp.cpp中的Product记录排序，对比三种做法
+//   1. std::sort + 逐字段比较的比较器
+//   2. 编码为保序字节键（sort_key.hpp），std::sort + memcmp比较键，再按下标取回记录
+//   3. 编码为保序字节键，MSD基数排序，再按下标取回记录
+// 2和3的计时包括编码和取回记录的时间；三种结果必须逐条一致
+#include <algorithm> // 提供std::sort
+#include <chrono>    // 提供计时功能
+#include <cmath>     // 提供INFINITY
+#include <cstdlib>   // 提供std::atol
+#include <cstring>   // 提供strncmp
+#include <iomanip>   // 提供setw/setprecision
+#include <iostream>
+#include <random>    // 提供随机数
+#include <vector>
+#include "sort_key.hpp"
+
+using namespace std;
+
+/* 与memcmp.cpp相同的结构体（name之后有填充字节，stock可能为负：预订超卖） */
+struct Product
+{
+    char name[10]; // 商品名称
+    float price;   // 价格
+    int stock;     // 库存
+};
+
+// 逐字段比较：价格升序，库存降序，名称升序
+bool field_less(const Product &a, const Product &b)
+{
+    if (a.price != b.price)
+        return a.price < b.price;
+    if (a.stock != b.stock)
+        return a.stock > b.stock;
+    return strncmp(a.name, b.name, sizeof a.name) < 0;
+}
+
+constexpr size_t key_size = 4 + 4 + sizeof(Product::name);
+using record_key = sortkey::keyed<key_size>;
+
+// 按与field_less相同的顺序编码：价格、库存（降序）、名称
+record_key make_key(const Product &p, uint32_t index)
+{
+    record_key k;
+    unsigned char *out = k.key.bytes;
+    out = sortkey::encode(out, p.price);
+    out = sortkey::encode_descending(out, p.stock);
+    sortkey::encode_string(out, p.name, sizeof p.name);
+    k.payload = index;
+    return k;
+}
+
+// 编码规则的基本检查：与memcmp.cpp场景5相反，编码后-1排在1之前
+bool self_check()
+{
+    unsigned char a[8], b[8];
+    auto less = [&](auto x, auto y) {
+        sortkey::encode(a, x);
+        sortkey::encode(b, y);
+        return memcmp(a, b, sizeof(x)) < 0;
+    };
+    bool ok = less(-1, 1) && less(-100, -99) && less(0u, 4000000000u) &&
+              less(-2.5f, -0.5f) && less(-0.5f, 0.25f) && less(-INFINITY, -1e30f) &&
+              less(1e30, static_cast<double>(INFINITY)) && less(-0.0f, 0.0f) &&
+              less(static_cast<long long>(-1), static_cast<long long>(0));
+    unsigned char s1[6], s2[6];
+    sortkey::encode_string(s1, "ab", 6);
+    sortkey::encode_string(s2, "abc", 6);
+    return ok && memcmp(s1, s2, 6) < 0;
+}
+
+template <typename Fn>
+vector<Product> timed(const char *name, Fn fn)
+{
+    auto start = chrono::steady_clock::now();
+    vector<Product> sorted = fn();
+    auto elapsed = chrono::steady_clock::now() - start;
+    cout << "  " << left << setw(32) << name << right << fixed << setprecision(1)
+         << setw(10) << chrono::duration<double, milli>(elapsed).count() << " ms\n";
+    return sorted;
+}
+
+// 先编码键，用sort_keys排序，再按下标取回记录
+template <typename SortKeys>
+vector<Product> sort_by_keys(const vector<Product> &input, SortKeys sort_keys)
+{
+    vector<record_key> keys(input.size());
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+        keys[i] = make_key(input[i], static_cast<uint32_t>(i));
+    }
+    sort_keys(keys);
+    vector<Product> sorted;
+    sorted.reserve(input.size());
+    for (const auto &k : keys)
+    {
+        sorted.push_back(input[k.payload]);
+    }
+    return sorted;
+}
+
+bool same_order(const vector<Product> &a, const vector<Product> &b)
+{
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        if (field_less(a[i], b[i]) || field_less(b[i], a[i]))
+        {
+            return false;
+        }
+    }
+    return a.size() == b.size();
+}
+
+int main(int argc, char *argv[])
+{
+    long count = argc > 1 ? atol(argv[1]) : 10000000;
+    if (count <= 0 || count > 0xFFFFFFFFL)
+    {
+        cerr << "用法: " << argv[0] << " [记录数]\n";
+        return 1;
+    }
+    if (!self_check())
+    {
+        cerr << "保序编码检查失败\n";
+        return 1;
+    }
+
+    // 价格取值有限（大量相同价格，需要比较后续字段），库存可正可负，名称为随机短字符串
+    mt19937 gen(7);
+    uniform_int_distribution<int> cents(0, 99999);
+    uniform_int_distribution<int> stock(-50, 500);
+    uniform_int_distribution<int> len(1, 9);
+    uniform_int_distribution<int> letter('a', 'z');
+    vector<Product> products(static_cast<size_t>(count));
+    for (auto &p : products)
+    {
+        memset(&p, 0xCC, sizeof p); // 填充字节和'\0'之后的残留都不是0，不能影响排序
+        int n = len(gen);
+        for (int i = 0; i < n; ++i)
+        {
+            p.name[i] = static_cast<char>(letter(gen));
+        }
+        p.name[n] = '\0';
+        p.price = cents(gen) / 100.0f;
+        p.stock = stock(gen);
+    }
+
+    cout << count << " 条Product记录，键长 " << key_size << " 字节\n";
+    auto a = timed("std::sort + 逐字段比较", [&] {
+        vector<Product> v = products;
+        sort(v.begin(), v.end(), field_less);
+        return v;
+    });
+    auto b = timed("保序键 + std::sort（memcmp）", [&] {
+        return sort_by_keys(products, [](vector<record_key> &keys) {
+            sort(keys.begin(), keys.end());
+        });
+    });
+    auto c = timed("保序键 + 基数排序", [&] {
+        return sort_by_keys(products, [](vector<record_key> &keys) {
+            sortkey::radix_sort(keys);
+        });
+    });
+
+    if (!same_order(a, b) || !same_order(a, c))
+    {
+        cerr << "排序结果不一致\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,146 @@
+// To compile: g++ -std=c++20 -O2 split_records_benchmark.cpp -o split_bench
+// To run:     ./split_bench [文本大小(MB)]
+
+// 程序功能：
+// 1. 演示delimiter_sentinel与split_records的用法（与null_sentinel.cpp中的三种遍历方式对应）
+// 2. 对比三种切分方式的吞吐量，并校验记录数与总字节数一致：
+//    - split_records（memchr / SSE2 多分隔符查找）
+//    - std::views::split（只支持单个分隔符）
+//    - 逐字节循环
+#include <algorithm> // 提供std::ranges::for_each
+#include <chrono>    // 提供计时功能
+#include <cstdlib>   // 提供std::atoi
+#include <iostream>
+#include <ranges>    // 提供std::views::split
+#include <string>
+#include <string_view>
+#include "../code/08 - iterators/split_records.hpp"
+
+using namespace std;
+
+struct split_stats
+{
+    size_t records = 0; // 记录条数
+    size_t bytes = 0;   // 记录总字节数（不含分隔符）
+    bool operator==(const split_stats &) const = default;
+};
+
+/**
+ * @brief 逐字节切分，作为基准实现
+ */
+template <char... Delims>
+split_stats split_by_bytes(string_view text)
+{
+    split_stats stats;
+    if (text.empty())
+        return stats;
+    size_t len = 0;
+    for (char ch : text)
+    {
+        if (delimiter_sentinel<Delims...>::is_delimiter(ch))
+        {
+            ++stats.records;
+            stats.bytes += len;
+            len = 0;
+        }
+        else
+        {
+            ++len;
+        }
+    }
+    ++stats.records; // 最后一个分隔符之后还有一条记录
+    stats.bytes += len;
+    return stats;
+}
+
+/**
+ * @brief 使用split_records切分，通过迭代器-哨兵对调用std::ranges::for_each
+ */
+template <char... Delims>
+split_stats split_by_records(string_view text)
+{
+    split_stats stats;
+    split_records<Delims...> records(text);
+    std::ranges::for_each(records.begin(), records.end(), [&](string_view rec) {
+        ++stats.records;
+        stats.bytes += rec.size();
+    });
+    return stats;
+}
+
+/**
+ * @brief 使用std::views::split按单个分隔符切分
+ */
+split_stats split_by_views(string_view text, char delim)
+{
+    split_stats stats;
+    for (auto rec : text | std::views::split(delim))
+    {
+        ++stats.records;
+        stats.bytes += std::ranges::distance(rec);
+    }
+    return stats;
+}
+
+/**
+ * @brief 计时并输出吞吐量
+ */
+template <typename F>
+split_stats report(const char *name, double mb, F fn)
+{
+    auto start = chrono::steady_clock::now();
+    split_stats stats = fn();
+    auto stop = chrono::steady_clock::now();
+    double ms = chrono::duration<double, milli>(stop - start).count();
+    cout << "  " << name << ": " << ms << " ms, " << mb / ms * 1000
+         << " MB/s（" << stats.records << " 条记录）\n";
+    return stats;
+}
+
+int main(int argc, char *argv[])
+{
+    // 用法演示：与null_sentinel.cpp相同，迭代器-哨兵对直接交给std::ranges::for_each
+    const char *msg = "name,age\nAlice,30\nBob,25";
+    cout << "第一行：";
+    std::ranges::for_each(msg, delimiter_sentinel<'\n', '\0'>{},
+                          [](char ch) { cout << ch; });
+    cout << "\n所有字段：";
+    for (string_view field : split_records<'\n', ','>(msg))
+    {
+        cout << '[' << field << ']';
+    }
+    cout << "\n\n";
+
+    // 生成测试文本：类似CSV的日志，每行若干字段
+    size_t megabytes = argc > 1 ? atoi(argv[1]) : 256;
+    string text;
+    text.reserve(megabytes << 20);
+    for (size_t i = 0; text.size() < megabytes << 20; ++i)
+    {
+        text += to_string(i);
+        text += ",user";
+        text += to_string(i % 97);
+        text += ",GET /index.html,200,";
+        text += to_string(i % 1000);
+        text += '\n';
+    }
+    double mb = text.size() / 1e6;
+
+    cout << "单个分隔符 '\\n'（" << mb << " MB）\n";
+    auto a1 = report("split_records<'\\n'>", mb,
+                     [&] { return split_by_records<'\n'>(text); });
+    auto a2 = report("std::views::split  ", mb,
+                     [&] { return split_by_views(text, '\n'); });
+    auto a3 = report("逐字节循环         ", mb,
+                     [&] { return split_by_bytes<'\n'>(text); });
+
+    cout << "多个分隔符 '\\n' ',' '\\0'\n";
+    auto b1 = report("split_records      ", mb,
+                     [&] { return split_by_records<'\n', ',', '\0'>(text); });
+    auto b2 = report("逐字节循环         ", mb,
+                     [&] { return split_by_bytes<'\n', ',', '\0'>(text); });
+
+    bool same = a1 == a2 && a1 == a3 && b1 == b2;
+    cout << "结果" << (same ? "一致" : "不一致") << '\n';
+    return same ? 0 : 1;
+}
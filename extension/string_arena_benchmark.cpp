@@ -0,0 +1,101 @@
+// To compile: g++ -std=c++17 -O2 string_arena_benchmark.cpp -o string_arena_bench
+// To run:     ./string_arena_bench [请求数] [每个请求的字符串数]
+
+// 程序功能：模拟“每个请求创建大量临时字符串、请求结束后全部丢弃”的场景，
+//           对比String的三种内存来源：
+//           1. 默认的new char[]/delete[]（每个字符串一次分配、一次释放）
+//           2. std::pmr::memory_resource*（从内存池分配，析构时仍调用deallocate）
+//           3. string_arena快速路径（从内存池分配，析构跳过释放，请求结束时整体释放）
+#include <array>    // 提供std::array
+#include <chrono>   // 提供计时功能
+#include <cstdio>   // 提供snprintf
+#include <cstdlib>  // 提供std::atoi
+#include <iostream>
+#include <memory_resource>
+#include <vector>
+#include "../code/01 - c and cpp basics/string.hpp"
+
+using namespace std;
+
+/**
+ * @brief 测量回调耗时（毫秒）
+ */
+template <typename F>
+double time_ms(F fn)
+{
+    auto start = chrono::steady_clock::now();
+    fn();
+    auto stop = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(stop - start).count();
+}
+
+int main(int argc, char *argv[])
+{
+    int requests = argc > 1 ? atoi(argv[1]) : 10;
+    size_t per_request = argc > 2 ? atoi(argv[2]) : 1000000;
+
+    // 预先生成字符串内容，避免把格式化开销计入测试
+    vector<array<char, 32>> texts(per_request);
+    for (size_t i = 0; i < per_request; ++i)
+    {
+        snprintf(texts[i].data(), texts[i].size(), "request-item-%zu", i);
+    }
+
+    size_t checksum1 = 0, checksum2 = 0, checksum3 = 0;
+
+    // 方式1：new/delete
+    double t1 = time_ms([&] {
+        for (int r = 0; r < requests; ++r)
+        {
+            vector<String> strings;
+            strings.reserve(per_request);
+            for (size_t i = 0; i < per_request; ++i)
+            {
+                strings.emplace_back(texts[i].data());
+            }
+            checksum1 += strings.back().size();
+        } // vector析构：每个String各调用一次delete[]
+    });
+
+    // 内存池的初始缓冲区在所有请求之间复用：release()后不再向上游申请，整体释放为O(1)
+    vector<char> arena_buffer(per_request * 64);
+
+    // 方式2：通用memory_resource接口（析构时仍逐个调用deallocate虚函数）
+    double t2 = time_ms([&] {
+        for (int r = 0; r < requests; ++r)
+        {
+            std::pmr::monotonic_buffer_resource pool(arena_buffer.data(),
+                                                     arena_buffer.size());
+            std::pmr::vector<String> strings(&pool);
+            strings.reserve(per_request);
+            for (size_t i = 0; i < per_request; ++i)
+            {
+                strings.emplace_back(texts[i].data(),
+                                     static_cast<std::pmr::memory_resource *>(&pool));
+            }
+            checksum2 += strings.back().size();
+        }
+    });
+
+    // 方式3：string_arena快速路径
+    double t3 = time_ms([&] {
+        for (int r = 0; r < requests; ++r)
+        {
+            string_arena arena(arena_buffer.data(), arena_buffer.size());
+            std::pmr::vector<String> strings(&arena);
+            strings.reserve(per_request);
+            for (size_t i = 0; i < per_request; ++i)
+            {
+                strings.emplace_back(texts[i].data(), arena);
+            }
+            checksum3 += strings.back().size();
+        } // String析构跳过释放，arena析构时整体归还
+    });
+
+    cout << requests << " 个请求 × " << per_request << " 个字符串\n"
+         << "new/delete          : " << t1 / requests << " ms/请求\n"
+         << "memory_resource*    : " << t2 / requests << " ms/请求\n"
+         << "string_arena快速路径: " << t3 / requests << " ms/请求，"
+         << "相对new/delete加速 " << t1 / t3 << " 倍\n";
+    return checksum1 == checksum2 && checksum2 == checksum3 ? 0 : 1;
+}
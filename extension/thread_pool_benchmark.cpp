@@ -0,0 +1,180 @@
+// To compile: g++ -std=c++17 -O2 -pthread thread_pool_benchmark.cpp -o thread_pool_bench
+// To run:     ./thread_pool_bench [细粒度任务数] [粗粒度任务数]
+
+// 程序功能：thread_pool.hpp的扩展性测试，对比工作窃取线程池与std::async
+//   任务：忙等待固定时长（细粒度1微秒，粗粒度1毫秒），模拟纯计算
+//   线程数：1、2、4、8
+//   方式：
+//     1. pool.submit：每个任务一次submit，保存future后逐个get
+//     2. pool.parallel_for：grain为1，由线程池拆分
+//     3. std::async（按线程数分批）：启动与线程数相同的std::async，每个顺序执行一批任务
+//     4. std::async（每个任务一个）：每个任务单独启动一个线程（与线程数无关，只测一次）
+//   效率 = 理想耗时（总任务时长 / 线程数）/ 实际耗时；受机器的物理核数限制
+// 每种方式都统计实际执行的任务数并核对submit返回的结果
+#include <atomic>  // 提供std::atomic
+#include <chrono>  // 提供计时功能
+#include <cstdlib> // 提供std::atol
+#include <future>  // 提供std::async/future
+#include <iomanip> // 提供setw/setprecision
+#include <iostream>
+#include <thread>  // 提供std::thread::hardware_concurrency
+#include <vector>
+#include "../code/16 - concurrency programming/thread_pool.hpp"
+
+using namespace std;
+
+// 忙等待d，返回参数i（用于核对结果）
+size_t spin(chrono::nanoseconds d, size_t i)
+{
+    auto until = chrono::steady_clock::now() + d;
+    while (chrono::steady_clock::now() < until)
+    {
+    }
+    return i;
+}
+
+struct scenario
+{
+    const char *name;
+    chrono::nanoseconds duration;
+    size_t tasks;
+};
+
+template <typename Fn>
+bool measure(const char *method, const scenario &s, unsigned threads, Fn fn)
+{
+    auto start = chrono::steady_clock::now();
+    size_t done = fn();
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    double ideal = chrono::duration<double, milli>(s.duration).count() * s.tasks / threads;
+    cout << "    " << left << setw(34) << method << right << fixed << setprecision(2) << setw(10)
+         << ms << " ms  效率" << setw(7) << setprecision(1) << 100 * ideal / ms << "%\n";
+    if (done != s.tasks)
+    {
+        cerr << method << "：执行了 " << done << " 个任务，应为 " << s.tasks << '\n';
+        return false;
+    }
+    return true;
+}
+
+bool run(const scenario &s)
+{
+    const size_t expected_sum = s.tasks * (s.tasks - 1) / 2;
+    cout << s.name << "：" << s.tasks << " 个任务\n";
+    bool ok = true;
+    for (unsigned threads : {1u, 2u, 4u, 8u})
+    {
+        cout << "  " << threads << " 个线程\n";
+        thread_pool pool(threads);
+
+        ok &= measure("thread_pool::submit", s, threads, [&] {
+            vector<future<size_t>> results;
+            results.reserve(s.tasks);
+            for (size_t i = 0; i < s.tasks; ++i)
+            {
+                results.push_back(pool.submit(spin, s.duration, i));
+            }
+            size_t sum = 0;
+            for (auto &f : results)
+            {
+                sum += f.get();
+            }
+            return sum == expected_sum ? results.size() : 0;
+        });
+
+        ok &= measure("thread_pool::parallel_for", s, threads, [&] {
+            atomic<size_t> done{0};
+            pool.parallel_for(0, s.tasks, 1, [&](size_t i) {
+                spin(s.duration, i);
+                done.fetch_add(1, memory_order_relaxed);
+            });
+            return done.load();
+        });
+
+        ok &= measure("std::async（按线程数分批）", s, threads, [&] {
+            vector<future<size_t>> batches;
+            for (unsigned t = 0; t < threads; ++t)
+            {
+                batches.push_back(async(launch::async, [&s, t, threads] {
+                    size_t n = 0;
+                    for (size_t i = t; i < s.tasks; i += threads, ++n)
+                    {
+                        spin(s.duration, i);
+                    }
+                    return n;
+                }));
+            }
+            size_t done = 0;
+            for (auto &f : batches)
+            {
+                done += f.get();
+            }
+            return done;
+        });
+    }
+
+    cout << "  与线程数无关\n";
+    ok &= measure("std::async（每个任务一个）", s, 1, [&] {
+        vector<future<size_t>> results;
+        results.reserve(s.tasks);
+        for (size_t i = 0; i < s.tasks; ++i)
+        {
+            results.push_back(async(launch::async, spin, s.duration, i));
+        }
+        size_t sum = 0;
+        for (auto &f : results)
+        {
+            sum += f.get();
+        }
+        return sum == expected_sum ? results.size() : 0;
+    });
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    long fine = argc > 1 ? atol(argv[1]) : 100000;
+    long coarse = argc > 2 ? atol(argv[2]) : 400;
+    if (fine <= 0 || coarse <= 0)
+    {
+        cerr << "用法: " << argv[0] << " [细粒度任务数] [粗粒度任务数]\n";
+        return 1;
+    }
+
+    // 线程池的异常传递：submit通过future，parallel_for直接重新抛出
+    {
+        thread_pool pool(2);
+        auto f = pool.submit([] { throw 42; });
+        bool ok = false;
+        try
+        {
+            f.get();
+        }
+        catch (int x)
+        {
+            ok = x == 42;
+        }
+        try
+        {
+            pool.parallel_for(0, 100, 1, [](size_t i) {
+                if (i == 57)
+                    throw i;
+            });
+            ok = false;
+        }
+        catch (size_t i)
+        {
+            ok = ok && i == 57;
+        }
+        if (!ok)
+        {
+            cerr << "异常没有正确传递\n";
+            return 1;
+        }
+    }
+
+    cout << "硬件线程数 " << thread::hardware_concurrency() << '\n';
+    bool ok = run({"细粒度（1微秒）", chrono::microseconds(1), static_cast<size_t>(fine)}) &&
+              run({"粗粒度（1毫秒）", chrono::milliseconds(1), static_cast<size_t>(coarse)});
+    return ok ? 0 : 1;
+}
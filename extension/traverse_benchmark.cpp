@@ -0,0 +1,124 @@
+// To compile: g++ -std=c++17 -O2 -pthread traverse_benchmark.cpp -o traverse_bench
+// To run:     ./traverse_bench [重复次数]
+
+// 程序功能：对比traverse.hpp中三种执行策略（seq/unseq/par）在两种数据上的速度
+//   数据：vector<int>与int[N]（N = 2^24，各64MB；C数组走traits<T[N]>特化）
+//   内核：求和（reduce，int累加到long long）与变换（for_each，x = x * 3 + 1）
+//   par分别使用硬件线程数、固定4个线程（每次调用都创建线程）和thread_pool（par.on(pool)，线程只创建一次）
+// 每种组合重复执行若干次取最短时间；所有策略的求和结果、变换后的校验和必须一致
+#include <chrono>     // 提供计时功能
+#include <cstdlib>    // 提供std::atoi
+#include <functional> // 提供std::plus
+#include <iomanip>    // 提供setw/setprecision
+#include <iostream>
+#include <thread>     // 提供std::thread::hardware_concurrency
+#include <vector>
+#include "../code/04 - templates and auto type deduction/traverse.hpp"
+
+using namespace std;
+
+constexpr size_t N = size_t(1) << 24;
+int array_data[N]; // 静态存储期的C数组，避免占用栈空间
+
+template <typename Fn>
+double best_ms(int repeats, Fn fn)
+{
+    double best = 0;
+    for (int r = 0; r < repeats; ++r)
+    {
+        auto start = chrono::steady_clock::now();
+        fn();
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        best = r == 0 ? ms : min(best, ms);
+    }
+    return best;
+}
+
+template <typename C>
+void fill_data(C &c)
+{
+    size_t i = 0;
+    traversal::for_each(traversal::seq, c, [&i](int &x) { x = static_cast<int>(i++ % 1000) - 500; });
+}
+
+void report(const char *kernel, const char *policy, double ms)
+{
+    cout << "    " << left << setw(6) << kernel << setw(14) << policy << right << fixed
+         << setprecision(2) << setw(9) << ms << " ms" << setw(9) << N / ms / 1e6
+         << " G元素/秒\n";
+}
+
+/**
+ * @brief 对容器c依次用各策略做求和与变换，返回0表示结果一致
+ */
+template <typename C, typename... Policies>
+int run(const char *name, C &c, int repeats, const Policies &...policies)
+{
+    cout << "  " << name << '\n';
+    const char *names[] = {"seq", "unseq", "par", "par(4线程)", "par(线程池)"};
+
+    long long expected_sum = 0;
+    int i = 0;
+    bool ok = true;
+    fill_data(c);
+    auto sum_with = [&](const auto &policy) {
+        long long total = 0;
+        double ms = best_ms(repeats, [&] {
+            total = traversal::reduce(policy, static_cast<const C &>(c), 0LL, plus<>());
+        });
+        report("求和", names[i], ms);
+        if (i++ == 0)
+            expected_sum = total;
+        ok = ok && total == expected_sum;
+    };
+    (sum_with(policies), ...);
+
+    long long expected_check = 0;
+    i = 0;
+    auto transform_with = [&](const auto &policy) {
+        double ms = 0;
+        for (int r = 0; r < repeats; ++r)
+        {
+            fill_data(c); // 不计时：每次从相同的初值开始
+            auto start = chrono::steady_clock::now();
+            traversal::for_each(policy, c, [](int &x) { x = x * 3 + 1; });
+            double t = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            ms = r == 0 ? t : min(ms, t);
+        }
+        report("变换", names[i], ms);
+        long long check = traversal::reduce(traversal::seq, static_cast<const C &>(c), 0LL, plus<>());
+        if (i++ == 0)
+            expected_check = check;
+        ok = ok && check == expected_check;
+    };
+    (transform_with(policies), ...);
+
+    if (!ok)
+    {
+        cerr << name << "：各策略的结果不一致\n";
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    int repeats = argc > 1 ? atoi(argv[1]) : 5;
+    if (repeats <= 0)
+    {
+        cerr << "用法: " << argv[0] << " [重复次数]\n";
+        return 1;
+    }
+
+    cout << N << " 个int，硬件线程数 " << thread::hardware_concurrency() << '\n';
+    vector<int> v(N);
+    auto par4 = traversal::par.with(4);
+    thread_pool pool;
+    auto pooled = traversal::par.on(pool);
+    if (run("vector<int>", v, repeats, traversal::seq, traversal::unseq, traversal::par, par4, pooled) != 0 ||
+        run("int[N]", array_data, repeats, traversal::seq, traversal::unseq, traversal::par, par4, pooled) != 0)
+    {
+        return 1;
+    }
+    return 0;
+}